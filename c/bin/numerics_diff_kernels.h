@@ -0,0 +1,9444 @@
+/* Generated by diff_kernels_gen - do not edit */
+
+#define DIFF_MAX_ORDER 4
+#define DIFF_MAX_WIDTH 9
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O1_W3[3 * 3] = {
+    -3.0 / 2.0, 2.0, -1.0 / 2.0,
+    -1.0 / 2.0, 0.0, 1.0 / 2.0,
+    1.0 / 2.0, -2.0, 3.0 / 2.0,
+};
+
+static void diff_uniform_o1_w3(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 2.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-in[i - 1]
+                      + in[i + 1]);
+    }
+}
+
+static void diff_weights_o1_w3(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+
+    double e0 = 1.0;
+    double e1;
+
+    e1 = d1 * e0;
+    e1 += d2 * e0;
+    w[0] = 1.0 * e1 / ((x[0] - x[1]) * (x[0] - x[2]));
+
+    e1 = d0 * e0;
+    e1 += d2 * e0;
+    w[1] = 1.0 * e1 / ((x[1] - x[0]) * (x[1] - x[2]));
+
+    e1 = d0 * e0;
+    e1 += d1 * e0;
+    w[2] = 1.0 * e1 / ((x[2] - x[0]) * (x[2] - x[1]));
+}
+
+static void diff_nonuniform_o1_w3(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[3];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o1_w3(x[i], x + i - 1, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 1];
+        sum += w[1] * in[i];
+        sum += w[2] * in[i + 1];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o1_w3_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 2.0;
+    const __m256d vs = _mm256_set1_pd(s);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_xor_pd(sign, _mm256_loadu_pd(in + i - 1));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(in + i + 1));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w3(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o1_w3_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p1 = _mm256_loadu_pd(x + i);
+        const __m256d p2 = _mm256_loadu_pd(x + i + 1);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w3(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o1_w3_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 2.0;
+    const __m512d vs = _mm512_set1_pd(s);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_xor_pd(sign, _mm512_loadu_pd(in + i - 1));
+        sum = _mm512_add_pd(sum, _mm512_loadu_pd(in + i + 1));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w3(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o1_w3_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p1 = _mm512_loadu_pd(x + i);
+        const __m512d p2 = _mm512_loadu_pd(x + i + 1);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w3(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O1_W5[5 * 5] = {
+    -25.0 / 12.0, 4.0, -3.0, 4.0 / 3.0, -1.0 / 4.0,
+    -1.0 / 4.0, -5.0 / 6.0, 3.0 / 2.0, -1.0 / 2.0, 1.0 / 12.0,
+    1.0 / 12.0, -2.0 / 3.0, 0.0, 2.0 / 3.0, -1.0 / 12.0,
+    -1.0 / 12.0, 1.0 / 2.0, -3.0 / 2.0, 5.0 / 6.0, 1.0 / 4.0,
+    1.0 / 4.0, -4.0 / 3.0, 3.0, -4.0, 25.0 / 12.0,
+};
+
+static void diff_uniform_o1_w5(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 12.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (in[i - 2]
+                      - 8.0 * in[i - 1]
+                      + 8.0 * in[i + 1]
+                      - in[i + 2]);
+    }
+}
+
+static void diff_weights_o1_w5(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+
+    double e0 = 1.0;
+    double e1, e2, e3;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[0] = 1.0 * e3 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[1] = 1.0 * e3 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[2] = 1.0 * e3 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[3] = 1.0 * e3 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    w[4] = 1.0 * e3 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]));
+}
+
+static void diff_nonuniform_o1_w5(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[5];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o1_w5(x[i], x + i - 2, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 2];
+        sum += w[1] * in[i - 1];
+        sum += w[2] * in[i];
+        sum += w[3] * in[i + 1];
+        sum += w[4] * in[i + 2];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o1_w5_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 12.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_loadu_pd(in + i - 2);
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_loadu_pd(in + i + 2));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o1_w5_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p2 = _mm256_loadu_pd(x + i);
+        const __m256d p3 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 2);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w5(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o1_w5_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 12.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_loadu_pd(in + i - 2);
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_loadu_pd(in + i + 2));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o1_w5_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p2 = _mm512_loadu_pd(x + i);
+        const __m512d p3 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 2);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w5(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O1_W7[7 * 7] = {
+    -49.0 / 20.0, 6.0, -15.0 / 2.0, 20.0 / 3.0, -15.0 / 4.0, 6.0 / 5.0, -1.0 / 6.0,
+    -1.0 / 6.0, -77.0 / 60.0, 5.0 / 2.0, -5.0 / 3.0, 5.0 / 6.0, -1.0 / 4.0, 1.0 / 30.0,
+    1.0 / 30.0, -2.0 / 5.0, -7.0 / 12.0, 4.0 / 3.0, -1.0 / 2.0, 2.0 / 15.0, -1.0 / 60.0,
+    -1.0 / 60.0, 3.0 / 20.0, -3.0 / 4.0, 0.0, 3.0 / 4.0, -3.0 / 20.0, 1.0 / 60.0,
+    1.0 / 60.0, -2.0 / 15.0, 1.0 / 2.0, -4.0 / 3.0, 7.0 / 12.0, 2.0 / 5.0, -1.0 / 30.0,
+    -1.0 / 30.0, 1.0 / 4.0, -5.0 / 6.0, 5.0 / 3.0, -5.0 / 2.0, 77.0 / 60.0, 1.0 / 6.0,
+    1.0 / 6.0, -6.0 / 5.0, 15.0 / 4.0, -20.0 / 3.0, 15.0 / 2.0, -6.0, 49.0 / 20.0,
+};
+
+static void diff_uniform_o1_w7(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 60.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-in[i - 3]
+                      + 9.0 * in[i - 2]
+                      - 45.0 * in[i - 1]
+                      + 45.0 * in[i + 1]
+                      - 9.0 * in[i + 2]
+                      + in[i + 3]);
+    }
+}
+
+static void diff_weights_o1_w7(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4, e5;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[0] = 1.0 * e5 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[1] = 1.0 * e5 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[2] = 1.0 * e5 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[3] = 1.0 * e5 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[4] = 1.0 * e5 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[5] = 1.0 * e5 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    w[6] = 1.0 * e5 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]));
+}
+
+static void diff_nonuniform_o1_w7(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[7];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o1_w7(x[i], x + i - 3, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 3];
+        sum += w[1] * in[i - 2];
+        sum += w[2] * in[i - 1];
+        sum += w[3] * in[i];
+        sum += w[4] * in[i + 1];
+        sum += w[5] * in[i + 2];
+        sum += w[6] * in[i + 3];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o1_w7_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 60.0;
+    const __m256d vs = _mm256_set1_pd(s);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_xor_pd(sign, _mm256_loadu_pd(in + i - 3));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(9.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(45.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(45.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(9.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(in + i + 3));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o1_w7_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p3 = _mm256_loadu_pd(x + i);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 3);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4, e5;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w7(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o1_w7_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 60.0;
+    const __m512d vs = _mm512_set1_pd(s);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_xor_pd(sign, _mm512_loadu_pd(in + i - 3));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(9.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(45.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(45.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(9.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_add_pd(sum, _mm512_loadu_pd(in + i + 3));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o1_w7_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p3 = _mm512_loadu_pd(x + i);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 3);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4, e5;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w7(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O1_W9[9 * 9] = {
+    -761.0 / 280.0, 8.0, -14.0, 56.0 / 3.0, -35.0 / 2.0, 56.0 / 5.0, -14.0 / 3.0, 8.0 / 7.0, -1.0 / 8.0,
+    -1.0 / 8.0, -223.0 / 140.0, 7.0 / 2.0, -7.0 / 2.0, 35.0 / 12.0, -7.0 / 4.0, 7.0 / 10.0, -1.0 / 6.0, 1.0 / 56.0,
+    1.0 / 56.0, -2.0 / 7.0, -19.0 / 20.0, 2.0, -5.0 / 4.0, 2.0 / 3.0, -1.0 / 4.0, 2.0 / 35.0, -1.0 / 168.0,
+    -1.0 / 168.0, 1.0 / 14.0, -1.0 / 2.0, -9.0 / 20.0, 5.0 / 4.0, -1.0 / 2.0, 1.0 / 6.0, -1.0 / 28.0, 1.0 / 280.0,
+    1.0 / 280.0, -4.0 / 105.0, 1.0 / 5.0, -4.0 / 5.0, 0.0, 4.0 / 5.0, -1.0 / 5.0, 4.0 / 105.0, -1.0 / 280.0,
+    -1.0 / 280.0, 1.0 / 28.0, -1.0 / 6.0, 1.0 / 2.0, -5.0 / 4.0, 9.0 / 20.0, 1.0 / 2.0, -1.0 / 14.0, 1.0 / 168.0,
+    1.0 / 168.0, -2.0 / 35.0, 1.0 / 4.0, -2.0 / 3.0, 5.0 / 4.0, -2.0, 19.0 / 20.0, 2.0 / 7.0, -1.0 / 56.0,
+    -1.0 / 56.0, 1.0 / 6.0, -7.0 / 10.0, 7.0 / 4.0, -35.0 / 12.0, 7.0 / 2.0, -7.0 / 2.0, 223.0 / 140.0, 1.0 / 8.0,
+    1.0 / 8.0, -8.0 / 7.0, 14.0 / 3.0, -56.0 / 5.0, 35.0 / 2.0, -56.0 / 3.0, 14.0, -8.0, 761.0 / 280.0,
+};
+
+static void diff_uniform_o1_w9(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 840.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (3.0 * in[i - 4]
+                      - 32.0 * in[i - 3]
+                      + 168.0 * in[i - 2]
+                      - 672.0 * in[i - 1]
+                      + 672.0 * in[i + 1]
+                      - 168.0 * in[i + 2]
+                      + 32.0 * in[i + 3]
+                      - 3.0 * in[i + 4]);
+    }
+}
+
+static void diff_weights_o1_w9(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+    const double d7 = x0 - x[7];
+    const double d8 = x0 - x[8];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4, e5, e6, e7;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[0] = 1.0 * e7 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]) * (x[0] - x[7]) * (x[0] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[1] = 1.0 * e7 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]) * (x[1] - x[7]) * (x[1] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[2] = 1.0 * e7 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]) * (x[2] - x[7]) * (x[2] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[3] = 1.0 * e7 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]) * (x[3] - x[7]) * (x[3] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[4] = 1.0 * e7 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]) * (x[4] - x[7]) * (x[4] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[5] = 1.0 * e7 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]) * (x[5] - x[7]) * (x[5] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e7 = d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[6] = 1.0 * e7 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]) * (x[6] - x[7]) * (x[6] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e7 = d6 * e6;
+    e6 += d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 += d8 * e6;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[7] = 1.0 * e7 / ((x[7] - x[0]) * (x[7] - x[1]) * (x[7] - x[2]) * (x[7] - x[3]) * (x[7] - x[4]) * (x[7] - x[5]) * (x[7] - x[6]) * (x[7] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e7 = d6 * e6;
+    e6 += d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e7 += d7 * e6;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    w[8] = 1.0 * e7 / ((x[8] - x[0]) * (x[8] - x[1]) * (x[8] - x[2]) * (x[8] - x[3]) * (x[8] - x[4]) * (x[8] - x[5]) * (x[8] - x[6]) * (x[8] - x[7]));
+}
+
+static void diff_nonuniform_o1_w9(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[9];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o1_w9(x[i], x + i - 4, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 4];
+        sum += w[1] * in[i - 3];
+        sum += w[2] * in[i - 2];
+        sum += w[3] * in[i - 1];
+        sum += w[4] * in[i];
+        sum += w[5] * in[i + 1];
+        sum += w[6] * in[i + 2];
+        sum += w[7] * in[i + 3];
+        sum += w[8] * in[i + 4];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o1_w9_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 840.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_mul_pd(_mm256_set1_pd(3.0), _mm256_loadu_pd(in + i - 4));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(32.0), _mm256_loadu_pd(in + i - 3)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(168.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(672.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(672.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(168.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(32.0), _mm256_loadu_pd(in + i + 3)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(3.0), _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o1_w9_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 4);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p3 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p7 = _mm256_loadu_pd(x + i + 3);
+        const __m256d p8 = _mm256_loadu_pd(x + i + 4);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+        const __m256d d7 = _mm256_sub_pd(x0, p7);
+        const __m256d d8 = _mm256_sub_pd(x0, p8);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4, e5, e6, e7;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 4)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e7 = _mm256_mul_pd(d7, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e7 = _mm256_mul_pd(d6, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d6, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d8, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p7, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e7 = _mm256_mul_pd(d6, e6);
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d6, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e7 = _mm256_add_pd(e7, _mm256_mul_pd(d7, e6));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        w = _mm256_sub_pd(p8, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p7));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.0), e7), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w9(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o1_w9_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 840.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_mul_pd(_mm512_set1_pd(3.0), _mm512_loadu_pd(in + i - 4));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(32.0), _mm512_loadu_pd(in + i - 3)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(168.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(672.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(672.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(168.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(32.0), _mm512_loadu_pd(in + i + 3)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(3.0), _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o1_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o1_w9_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 4);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p3 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p7 = _mm512_loadu_pd(x + i + 3);
+        const __m512d p8 = _mm512_loadu_pd(x + i + 4);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+        const __m512d d7 = _mm512_sub_pd(x0, p7);
+        const __m512d d8 = _mm512_sub_pd(x0, p8);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4, e5, e6, e7;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 4)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e7 = _mm512_mul_pd(d7, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e7 = _mm512_mul_pd(d6, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d6, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d8, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p7, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e7 = _mm512_mul_pd(d6, e6);
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d6, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e7 = _mm512_add_pd(e7, _mm512_mul_pd(d7, e6));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        w = _mm512_sub_pd(p8, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p7));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(1.0), e7), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o1_w9(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O2_W3[3 * 3] = {
+    1.0, -2.0, 1.0,
+    1.0, -2.0, 1.0,
+    1.0, -2.0, 1.0,
+};
+
+static void diff_uniform_o2_w3(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 1.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (in[i - 1]
+                      - 2.0 * in[i]
+                      + in[i + 1]);
+    }
+}
+
+static void diff_weights_o2_w3(double x0, const double *x,
+                               double *w) {
+    double e0 = 1.0;
+
+    w[0] = 2.0 * e0 / ((x[0] - x[1]) * (x[0] - x[2]));
+
+    w[1] = 2.0 * e0 / ((x[1] - x[0]) * (x[1] - x[2]));
+
+    w[2] = 2.0 * e0 / ((x[2] - x[0]) * (x[2] - x[1]));
+}
+
+static void diff_nonuniform_o2_w3(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[3];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o2_w3(x[i], x + i - 1, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 1];
+        sum += w[1] * in[i];
+        sum += w[2] * in[i + 1];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o2_w3_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 1.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_loadu_pd(in + i - 1);
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(in + i + 1));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w3(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o2_w3_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d p0 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p1 = _mm256_loadu_pd(x + i);
+        const __m256d p2 = _mm256_loadu_pd(x + i + 1);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w3(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o2_w3_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 1.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_loadu_pd(in + i - 1);
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(2.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_add_pd(sum, _mm512_loadu_pd(in + i + 1));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w3(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o2_w3_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d p0 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p1 = _mm512_loadu_pd(x + i);
+        const __m512d p2 = _mm512_loadu_pd(x + i + 1);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w3(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O2_W5[5 * 5] = {
+    35.0 / 12.0, -26.0 / 3.0, 19.0 / 2.0, -14.0 / 3.0, 11.0 / 12.0,
+    11.0 / 12.0, -5.0 / 3.0, 1.0 / 2.0, 1.0 / 3.0, -1.0 / 12.0,
+    -1.0 / 12.0, 4.0 / 3.0, -5.0 / 2.0, 4.0 / 3.0, -1.0 / 12.0,
+    -1.0 / 12.0, 1.0 / 3.0, 1.0 / 2.0, -5.0 / 3.0, 11.0 / 12.0,
+    11.0 / 12.0, -14.0 / 3.0, 19.0 / 2.0, -26.0 / 3.0, 35.0 / 12.0,
+};
+
+static void diff_uniform_o2_w5(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 12.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-in[i - 2]
+                      + 16.0 * in[i - 1]
+                      - 30.0 * in[i]
+                      + 16.0 * in[i + 1]
+                      - in[i + 2]);
+    }
+}
+
+static void diff_weights_o2_w5(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+
+    double e0 = 1.0;
+    double e1, e2;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[0] = 2.0 * e2 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[1] = 2.0 * e2 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[2] = 2.0 * e2 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    w[3] = 2.0 * e2 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    w[4] = 2.0 * e2 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]));
+}
+
+static void diff_nonuniform_o2_w5(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[5];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o2_w5(x[i], x + i - 2, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 2];
+        sum += w[1] * in[i - 1];
+        sum += w[2] * in[i];
+        sum += w[3] * in[i + 1];
+        sum += w[4] * in[i + 2];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o2_w5_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 12.0;
+    const __m256d vs = _mm256_set1_pd(s);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_xor_pd(sign, _mm256_loadu_pd(in + i - 2));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(16.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(30.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(16.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_loadu_pd(in + i + 2));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o2_w5_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p2 = _mm256_loadu_pd(x + i);
+        const __m256d p3 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 2);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w5(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o2_w5_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 12.0;
+    const __m512d vs = _mm512_set1_pd(s);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_xor_pd(sign, _mm512_loadu_pd(in + i - 2));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(16.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(30.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(16.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_loadu_pd(in + i + 2));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o2_w5_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p2 = _mm512_loadu_pd(x + i);
+        const __m512d p3 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 2);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w5(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O2_W7[7 * 7] = {
+    203.0 / 45.0, -87.0 / 5.0, 117.0 / 4.0, -254.0 / 9.0, 33.0 / 2.0, -27.0 / 5.0, 137.0 / 180.0,
+    137.0 / 180.0, -49.0 / 60.0, -17.0 / 12.0, 47.0 / 18.0, -19.0 / 12.0, 31.0 / 60.0, -13.0 / 180.0,
+    -13.0 / 180.0, 19.0 / 15.0, -7.0 / 3.0, 10.0 / 9.0, 1.0 / 12.0, -1.0 / 15.0, 1.0 / 90.0,
+    1.0 / 90.0, -3.0 / 20.0, 3.0 / 2.0, -49.0 / 18.0, 3.0 / 2.0, -3.0 / 20.0, 1.0 / 90.0,
+    1.0 / 90.0, -1.0 / 15.0, 1.0 / 12.0, 10.0 / 9.0, -7.0 / 3.0, 19.0 / 15.0, -13.0 / 180.0,
+    -13.0 / 180.0, 31.0 / 60.0, -19.0 / 12.0, 47.0 / 18.0, -17.0 / 12.0, -49.0 / 60.0, 137.0 / 180.0,
+    137.0 / 180.0, -27.0 / 5.0, 33.0 / 2.0, -254.0 / 9.0, 117.0 / 4.0, -87.0 / 5.0, 203.0 / 45.0,
+};
+
+static void diff_uniform_o2_w7(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 180.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (2.0 * in[i - 3]
+                      - 27.0 * in[i - 2]
+                      + 270.0 * in[i - 1]
+                      - 490.0 * in[i]
+                      + 270.0 * in[i + 1]
+                      - 27.0 * in[i + 2]
+                      + 2.0 * in[i + 3]);
+    }
+}
+
+static void diff_weights_o2_w7(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[0] = 2.0 * e4 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[1] = 2.0 * e4 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[2] = 2.0 * e4 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[3] = 2.0 * e4 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[4] = 2.0 * e4 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[5] = 2.0 * e4 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    w[6] = 2.0 * e4 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]));
+}
+
+static void diff_nonuniform_o2_w7(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[7];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o2_w7(x[i], x + i - 3, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 3];
+        sum += w[1] * in[i - 2];
+        sum += w[2] * in[i - 1];
+        sum += w[3] * in[i];
+        sum += w[4] * in[i + 1];
+        sum += w[5] * in[i + 2];
+        sum += w[6] * in[i + 3];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o2_w7_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 180.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_loadu_pd(in + i - 3));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(27.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(270.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(490.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(270.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(27.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_loadu_pd(in + i + 3)));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o2_w7_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p3 = _mm256_loadu_pd(x + i);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 3);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w7(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o2_w7_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 180.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_mul_pd(_mm512_set1_pd(2.0), _mm512_loadu_pd(in + i - 3));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(27.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(270.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(490.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(270.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(27.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(2.0), _mm512_loadu_pd(in + i + 3)));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o2_w7_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p3 = _mm512_loadu_pd(x + i);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 3);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w7(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O2_W9[9 * 9] = {
+    29531.0 / 5040.0, -962.0 / 35.0, 621.0 / 10.0, -4006.0 / 45.0, 691.0 / 8.0, -282.0 / 5.0, 2143.0 / 90.0, -206.0 / 35.0, 363.0 / 560.0,
+    363.0 / 560.0, 8.0 / 315.0, -83.0 / 20.0, 153.0 / 20.0, -529.0 / 72.0, 47.0 / 10.0, -39.0 / 20.0, 599.0 / 1260.0, -29.0 / 560.0,
+    -29.0 / 560.0, 39.0 / 35.0, -331.0 / 180.0, 1.0 / 5.0, 9.0 / 8.0, -37.0 / 45.0, 7.0 / 20.0, -3.0 / 35.0, 47.0 / 5040.0,
+    47.0 / 5040.0, -19.0 / 140.0, 29.0 / 20.0, -118.0 / 45.0, 11.0 / 8.0, -1.0 / 20.0, -7.0 / 180.0, 1.0 / 70.0, -1.0 / 560.0,
+    -1.0 / 560.0, 8.0 / 315.0, -1.0 / 5.0, 8.0 / 5.0, -205.0 / 72.0, 8.0 / 5.0, -1.0 / 5.0, 8.0 / 315.0, -1.0 / 560.0,
+    -1.0 / 560.0, 1.0 / 70.0, -7.0 / 180.0, -1.0 / 20.0, 11.0 / 8.0, -118.0 / 45.0, 29.0 / 20.0, -19.0 / 140.0, 47.0 / 5040.0,
+    47.0 / 5040.0, -3.0 / 35.0, 7.0 / 20.0, -37.0 / 45.0, 9.0 / 8.0, 1.0 / 5.0, -331.0 / 180.0, 39.0 / 35.0, -29.0 / 560.0,
+    -29.0 / 560.0, 599.0 / 1260.0, -39.0 / 20.0, 47.0 / 10.0, -529.0 / 72.0, 153.0 / 20.0, -83.0 / 20.0, 8.0 / 315.0, 363.0 / 560.0,
+    363.0 / 560.0, -206.0 / 35.0, 2143.0 / 90.0, -282.0 / 5.0, 691.0 / 8.0, -4006.0 / 45.0, 621.0 / 10.0, -962.0 / 35.0, 29531.0 / 5040.0,
+};
+
+static void diff_uniform_o2_w9(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 5040.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-9.0 * in[i - 4]
+                      + 128.0 * in[i - 3]
+                      - 1008.0 * in[i - 2]
+                      + 8064.0 * in[i - 1]
+                      - 14350.0 * in[i]
+                      + 8064.0 * in[i + 1]
+                      - 1008.0 * in[i + 2]
+                      + 128.0 * in[i + 3]
+                      - 9.0 * in[i + 4]);
+    }
+}
+
+static void diff_weights_o2_w9(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+    const double d7 = x0 - x[7];
+    const double d8 = x0 - x[8];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4, e5, e6;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[0] = 2.0 * e6 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]) * (x[0] - x[7]) * (x[0] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[1] = 2.0 * e6 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]) * (x[1] - x[7]) * (x[1] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[2] = 2.0 * e6 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]) * (x[2] - x[7]) * (x[2] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[3] = 2.0 * e6 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]) * (x[3] - x[7]) * (x[3] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[4] = 2.0 * e6 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]) * (x[4] - x[7]) * (x[4] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[5] = 2.0 * e6 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]) * (x[5] - x[7]) * (x[5] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[6] = 2.0 * e6 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]) * (x[6] - x[7]) * (x[6] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 += d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d8 * e5;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[7] = 2.0 * e6 / ((x[7] - x[0]) * (x[7] - x[1]) * (x[7] - x[2]) * (x[7] - x[3]) * (x[7] - x[4]) * (x[7] - x[5]) * (x[7] - x[6]) * (x[7] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e6 = d5 * e5;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e6 += d6 * e5;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e6 += d7 * e5;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    w[8] = 2.0 * e6 / ((x[8] - x[0]) * (x[8] - x[1]) * (x[8] - x[2]) * (x[8] - x[3]) * (x[8] - x[4]) * (x[8] - x[5]) * (x[8] - x[6]) * (x[8] - x[7]));
+}
+
+static void diff_nonuniform_o2_w9(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[9];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o2_w9(x[i], x + i - 4, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 4];
+        sum += w[1] * in[i - 3];
+        sum += w[2] * in[i - 2];
+        sum += w[3] * in[i - 1];
+        sum += w[4] * in[i];
+        sum += w[5] * in[i + 1];
+        sum += w[6] * in[i + 2];
+        sum += w[7] * in[i + 3];
+        sum += w[8] * in[i + 4];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o2_w9_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 5040.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_mul_pd(_mm256_set1_pd(-9.0), _mm256_loadu_pd(in + i - 4));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(128.0), _mm256_loadu_pd(in + i - 3)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(1008.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8064.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(14350.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8064.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(1008.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(128.0), _mm256_loadu_pd(in + i + 3)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(9.0), _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o2_w9_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 4);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p3 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p7 = _mm256_loadu_pd(x + i + 3);
+        const __m256d p8 = _mm256_loadu_pd(x + i + 4);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+        const __m256d d7 = _mm256_sub_pd(x0, p7);
+        const __m256d d8 = _mm256_sub_pd(x0, p8);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4, e5, e6;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 4)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d6, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d6, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d8, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p7, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e6 = _mm256_mul_pd(d5, e5);
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d6, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e6 = _mm256_add_pd(e6, _mm256_mul_pd(d7, e5));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        w = _mm256_sub_pd(p8, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p7));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), e6), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w9(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o2_w9_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 5040.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_mul_pd(_mm512_set1_pd(-9.0), _mm512_loadu_pd(in + i - 4));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(128.0), _mm512_loadu_pd(in + i - 3)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(1008.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8064.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(14350.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8064.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(1008.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(128.0), _mm512_loadu_pd(in + i + 3)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(9.0), _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o2_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o2_w9_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 4);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p3 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p7 = _mm512_loadu_pd(x + i + 3);
+        const __m512d p8 = _mm512_loadu_pd(x + i + 4);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+        const __m512d d7 = _mm512_sub_pd(x0, p7);
+        const __m512d d8 = _mm512_sub_pd(x0, p8);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4, e5, e6;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 4)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d6, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d6, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d8, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p7, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e6 = _mm512_mul_pd(d5, e5);
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d6, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e6 = _mm512_add_pd(e6, _mm512_mul_pd(d7, e5));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        w = _mm512_sub_pd(p8, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p7));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(2.0), e6), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o2_w9(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O3_W5[5 * 5] = {
+    -5.0 / 2.0, 9.0, -12.0, 7.0, -3.0 / 2.0,
+    -3.0 / 2.0, 5.0, -6.0, 3.0, -1.0 / 2.0,
+    -1.0 / 2.0, 1.0, 0.0, -1.0, 1.0 / 2.0,
+    1.0 / 2.0, -3.0, 6.0, -5.0, 3.0 / 2.0,
+    3.0 / 2.0, -7.0, 12.0, -9.0, 5.0 / 2.0,
+};
+
+static void diff_uniform_o3_w5(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 2.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-in[i - 2]
+                      + 2.0 * in[i - 1]
+                      - 2.0 * in[i + 1]
+                      + in[i + 2]);
+    }
+}
+
+static void diff_weights_o3_w5(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+
+    double e0 = 1.0;
+    double e1;
+
+    e1 = d1 * e0;
+    e1 += d2 * e0;
+    e1 += d3 * e0;
+    e1 += d4 * e0;
+    w[0] = 6.0 * e1 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]));
+
+    e1 = d0 * e0;
+    e1 += d2 * e0;
+    e1 += d3 * e0;
+    e1 += d4 * e0;
+    w[1] = 6.0 * e1 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]));
+
+    e1 = d0 * e0;
+    e1 += d1 * e0;
+    e1 += d3 * e0;
+    e1 += d4 * e0;
+    w[2] = 6.0 * e1 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]));
+
+    e1 = d0 * e0;
+    e1 += d1 * e0;
+    e1 += d2 * e0;
+    e1 += d4 * e0;
+    w[3] = 6.0 * e1 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]));
+
+    e1 = d0 * e0;
+    e1 += d1 * e0;
+    e1 += d2 * e0;
+    e1 += d3 * e0;
+    w[4] = 6.0 * e1 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]));
+}
+
+static void diff_nonuniform_o3_w5(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[5];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o3_w5(x[i], x + i - 2, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 2];
+        sum += w[1] * in[i - 1];
+        sum += w[2] * in[i];
+        sum += w[3] * in[i + 1];
+        sum += w[4] * in[i + 2];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o3_w5_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 2.0;
+    const __m256d vs = _mm256_set1_pd(s);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_xor_pd(sign, _mm256_loadu_pd(in + i - 2));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(in + i + 2));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o3_w5_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p2 = _mm256_loadu_pd(x + i);
+        const __m256d p3 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 2);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e1), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w5(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o3_w5_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 2.0;
+    const __m512d vs = _mm512_set1_pd(s);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_xor_pd(sign, _mm512_loadu_pd(in + i - 2));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(2.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(2.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_loadu_pd(in + i + 2));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o3_w5_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p2 = _mm512_loadu_pd(x + i);
+        const __m512d p3 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 2);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e1), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w5(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O3_W7[7 * 7] = {
+    -49.0 / 8.0, 29.0, -461.0 / 8.0, 62.0, -307.0 / 8.0, 13.0, -15.0 / 8.0,
+    -15.0 / 8.0, 7.0, -83.0 / 8.0, 8.0, -29.0 / 8.0, 1.0, -1.0 / 8.0,
+    -1.0 / 8.0, -1.0, 35.0 / 8.0, -6.0, 29.0 / 8.0, -1.0, 1.0 / 8.0,
+    1.0 / 8.0, -1.0, 13.0 / 8.0, 0.0, -13.0 / 8.0, 1.0, -1.0 / 8.0,
+    -1.0 / 8.0, 1.0, -29.0 / 8.0, 6.0, -35.0 / 8.0, 1.0, 1.0 / 8.0,
+    1.0 / 8.0, -1.0, 29.0 / 8.0, -8.0, 83.0 / 8.0, -7.0, 15.0 / 8.0,
+    15.0 / 8.0, -13.0, 307.0 / 8.0, -62.0, 461.0 / 8.0, -29.0, 49.0 / 8.0,
+};
+
+static void diff_uniform_o3_w7(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 8.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (in[i - 3]
+                      - 8.0 * in[i - 2]
+                      + 13.0 * in[i - 1]
+                      - 13.0 * in[i + 1]
+                      + 8.0 * in[i + 2]
+                      - in[i + 3]);
+    }
+}
+
+static void diff_weights_o3_w7(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+
+    double e0 = 1.0;
+    double e1, e2, e3;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[0] = 6.0 * e3 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[1] = 6.0 * e3 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[2] = 6.0 * e3 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[3] = 6.0 * e3 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[4] = 6.0 * e3 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[5] = 6.0 * e3 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    w[6] = 6.0 * e3 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]));
+}
+
+static void diff_nonuniform_o3_w7(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[7];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o3_w7(x[i], x + i - 3, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 3];
+        sum += w[1] * in[i - 2];
+        sum += w[2] * in[i - 1];
+        sum += w[3] * in[i];
+        sum += w[4] * in[i + 1];
+        sum += w[5] * in[i + 2];
+        sum += w[6] * in[i + 3];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o3_w7_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 8.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_loadu_pd(in + i - 3);
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(13.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(13.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(8.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_sub_pd(sum, _mm256_loadu_pd(in + i + 3));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o3_w7_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p3 = _mm256_loadu_pd(x + i);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 3);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e3), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w7(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o3_w7_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 8.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_loadu_pd(in + i - 3);
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(13.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(13.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(8.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_sub_pd(sum, _mm512_loadu_pd(in + i + 3));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o3_w7_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p3 = _mm512_loadu_pd(x + i);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 3);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e3), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w7(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O3_W9[9 * 9] = {
+    -801.0 / 80.0, 349.0 / 6.0, -18353.0 / 120.0, 2391.0 / 10.0, -1457.0 / 6.0, 4891.0 / 30.0, -561.0 / 8.0, 527.0 / 30.0, -469.0 / 240.0,
+    -469.0 / 240.0, 303.0 / 40.0, -731.0 / 60.0, 269.0 / 24.0, -57.0 / 8.0, 407.0 / 120.0, -67.0 / 60.0, 9.0 / 40.0, -1.0 / 48.0,
+    -1.0 / 48.0, -53.0 / 30.0, 273.0 / 40.0, -313.0 / 30.0, 103.0 / 12.0, -9.0 / 2.0, 197.0 / 120.0, -11.0 / 30.0, 3.0 / 80.0,
+    3.0 / 80.0, -43.0 / 120.0, -5.0 / 12.0, 147.0 / 40.0, -137.0 / 24.0, 463.0 / 120.0, -27.0 / 20.0, 7.0 / 24.0, -7.0 / 240.0,
+    -7.0 / 240.0, 3.0 / 10.0, -169.0 / 120.0, 61.0 / 30.0, 0.0, -61.0 / 30.0, 169.0 / 120.0, -3.0 / 10.0, 7.0 / 240.0,
+    7.0 / 240.0, -7.0 / 24.0, 27.0 / 20.0, -463.0 / 120.0, 137.0 / 24.0, -147.0 / 40.0, 5.0 / 12.0, 43.0 / 120.0, -3.0 / 80.0,
+    -3.0 / 80.0, 11.0 / 30.0, -197.0 / 120.0, 9.0 / 2.0, -103.0 / 12.0, 313.0 / 30.0, -273.0 / 40.0, 53.0 / 30.0, 1.0 / 48.0,
+    1.0 / 48.0, -9.0 / 40.0, 67.0 / 60.0, -407.0 / 120.0, 57.0 / 8.0, -269.0 / 24.0, 731.0 / 60.0, -303.0 / 40.0, 469.0 / 240.0,
+    469.0 / 240.0, -527.0 / 30.0, 561.0 / 8.0, -4891.0 / 30.0, 1457.0 / 6.0, -2391.0 / 10.0, 18353.0 / 120.0, -349.0 / 6.0, 801.0 / 80.0,
+};
+
+static void diff_uniform_o3_w9(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 240.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-7.0 * in[i - 4]
+                      + 72.0 * in[i - 3]
+                      - 338.0 * in[i - 2]
+                      + 488.0 * in[i - 1]
+                      - 488.0 * in[i + 1]
+                      + 338.0 * in[i + 2]
+                      - 72.0 * in[i + 3]
+                      + 7.0 * in[i + 4]);
+    }
+}
+
+static void diff_weights_o3_w9(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+    const double d7 = x0 - x[7];
+    const double d8 = x0 - x[8];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4, e5;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[0] = 6.0 * e5 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]) * (x[0] - x[7]) * (x[0] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[1] = 6.0 * e5 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]) * (x[1] - x[7]) * (x[1] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[2] = 6.0 * e5 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]) * (x[2] - x[7]) * (x[2] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[3] = 6.0 * e5 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]) * (x[3] - x[7]) * (x[3] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[4] = 6.0 * e5 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]) * (x[4] - x[7]) * (x[4] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[5] = 6.0 * e5 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]) * (x[5] - x[7]) * (x[5] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[6] = 6.0 * e5 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]) * (x[6] - x[7]) * (x[6] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d8 * e4;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[7] = 6.0 * e5 / ((x[7] - x[0]) * (x[7] - x[1]) * (x[7] - x[2]) * (x[7] - x[3]) * (x[7] - x[4]) * (x[7] - x[5]) * (x[7] - x[6]) * (x[7] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e5 = d4 * e4;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e5 += d5 * e4;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e5 += d6 * e4;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e5 += d7 * e4;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    w[8] = 6.0 * e5 / ((x[8] - x[0]) * (x[8] - x[1]) * (x[8] - x[2]) * (x[8] - x[3]) * (x[8] - x[4]) * (x[8] - x[5]) * (x[8] - x[6]) * (x[8] - x[7]));
+}
+
+static void diff_nonuniform_o3_w9(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[9];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o3_w9(x[i], x + i - 4, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 4];
+        sum += w[1] * in[i - 3];
+        sum += w[2] * in[i - 2];
+        sum += w[3] * in[i - 1];
+        sum += w[4] * in[i];
+        sum += w[5] * in[i + 1];
+        sum += w[6] * in[i + 2];
+        sum += w[7] * in[i + 3];
+        sum += w[8] * in[i + 4];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o3_w9_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 240.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_mul_pd(_mm256_set1_pd(-7.0), _mm256_loadu_pd(in + i - 4));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(72.0), _mm256_loadu_pd(in + i - 3)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(338.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(488.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(488.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(338.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(72.0), _mm256_loadu_pd(in + i + 3)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(7.0), _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o3_w9_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 4);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p3 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p7 = _mm256_loadu_pd(x + i + 3);
+        const __m256d p8 = _mm256_loadu_pd(x + i + 4);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+        const __m256d d7 = _mm256_sub_pd(x0, p7);
+        const __m256d d8 = _mm256_sub_pd(x0, p8);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4, e5;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 4)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d5, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d8, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p7, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e5 = _mm256_mul_pd(d4, e4);
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d5, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d6, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e5 = _mm256_add_pd(e5, _mm256_mul_pd(d7, e4));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        w = _mm256_sub_pd(p8, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p7));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), e5), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w9(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o3_w9_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 240.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_mul_pd(_mm512_set1_pd(-7.0), _mm512_loadu_pd(in + i - 4));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(72.0), _mm512_loadu_pd(in + i - 3)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(338.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(488.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(488.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(338.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(72.0), _mm512_loadu_pd(in + i + 3)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(7.0), _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o3_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o3_w9_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 4);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p3 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p7 = _mm512_loadu_pd(x + i + 3);
+        const __m512d p8 = _mm512_loadu_pd(x + i + 4);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+        const __m512d d7 = _mm512_sub_pd(x0, p7);
+        const __m512d d8 = _mm512_sub_pd(x0, p8);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4, e5;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 4)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d5, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d8, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p7, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e5 = _mm512_mul_pd(d4, e4);
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d5, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d6, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e5 = _mm512_add_pd(e5, _mm512_mul_pd(d7, e4));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        w = _mm512_sub_pd(p8, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p7));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(6.0), e5), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o3_w9(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O4_W5[5 * 5] = {
+    1.0, -4.0, 6.0, -4.0, 1.0,
+    1.0, -4.0, 6.0, -4.0, 1.0,
+    1.0, -4.0, 6.0, -4.0, 1.0,
+    1.0, -4.0, 6.0, -4.0, 1.0,
+    1.0, -4.0, 6.0, -4.0, 1.0,
+};
+
+static void diff_uniform_o4_w5(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 1.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (in[i - 2]
+                      - 4.0 * in[i - 1]
+                      + 6.0 * in[i]
+                      - 4.0 * in[i + 1]
+                      + in[i + 2]);
+    }
+}
+
+static void diff_weights_o4_w5(double x0, const double *x,
+                               double *w) {
+    double e0 = 1.0;
+
+    w[0] = 24.0 * e0 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]));
+
+    w[1] = 24.0 * e0 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]));
+
+    w[2] = 24.0 * e0 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]));
+
+    w[3] = 24.0 * e0 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]));
+
+    w[4] = 24.0 * e0 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]));
+}
+
+static void diff_nonuniform_o4_w5(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[5];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o4_w5(x[i], x + i - 2, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 2];
+        sum += w[1] * in[i - 1];
+        sum += w[2] * in[i];
+        sum += w[3] * in[i + 1];
+        sum += w[4] * in[i + 2];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o4_w5_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 1.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_loadu_pd(in + i - 2);
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(4.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(6.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(4.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(in + i + 2));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o4_w5_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d p0 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p2 = _mm256_loadu_pd(x + i);
+        const __m256d p3 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 2);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e0), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w5(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o4_w5_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 1.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_loadu_pd(in + i - 2);
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(4.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(6.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(4.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_loadu_pd(in + i + 2));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w5(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o4_w5_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d p0 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p2 = _mm512_loadu_pd(x + i);
+        const __m512d p3 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 2);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e0), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w5(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O4_W7[7 * 7] = {
+    35.0 / 6.0, -31.0, 137.0 / 2.0, -242.0 / 3.0, 107.0 / 2.0, -19.0, 17.0 / 6.0,
+    17.0 / 6.0, -14.0, 57.0 / 2.0, -92.0 / 3.0, 37.0 / 2.0, -6.0, 5.0 / 6.0,
+    5.0 / 6.0, -3.0, 7.0 / 2.0, -2.0 / 3.0, -3.0 / 2.0, 1.0, -1.0 / 6.0,
+    -1.0 / 6.0, 2.0, -13.0 / 2.0, 28.0 / 3.0, -13.0 / 2.0, 2.0, -1.0 / 6.0,
+    -1.0 / 6.0, 1.0, -3.0 / 2.0, -2.0 / 3.0, 7.0 / 2.0, -3.0, 5.0 / 6.0,
+    5.0 / 6.0, -6.0, 37.0 / 2.0, -92.0 / 3.0, 57.0 / 2.0, -14.0, 17.0 / 6.0,
+    17.0 / 6.0, -19.0, 107.0 / 2.0, -242.0 / 3.0, 137.0 / 2.0, -31.0, 35.0 / 6.0,
+};
+
+static void diff_uniform_o4_w7(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 6.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (-in[i - 3]
+                      + 12.0 * in[i - 2]
+                      - 39.0 * in[i - 1]
+                      + 56.0 * in[i]
+                      - 39.0 * in[i + 1]
+                      + 12.0 * in[i + 2]
+                      - in[i + 3]);
+    }
+}
+
+static void diff_weights_o4_w7(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+
+    double e0 = 1.0;
+    double e1, e2;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[0] = 24.0 * e2 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[1] = 24.0 * e2 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[2] = 24.0 * e2 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[3] = 24.0 * e2 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[4] = 24.0 * e2 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    w[5] = 24.0 * e2 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    w[6] = 24.0 * e2 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]));
+}
+
+static void diff_nonuniform_o4_w7(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[7];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o4_w7(x[i], x + i - 3, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 3];
+        sum += w[1] * in[i - 2];
+        sum += w[2] * in[i - 1];
+        sum += w[3] * in[i];
+        sum += w[4] * in[i + 1];
+        sum += w[5] * in[i + 2];
+        sum += w[6] * in[i + 3];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o4_w7_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 6.0;
+    const __m256d vs = _mm256_set1_pd(s);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_xor_pd(sign, _mm256_loadu_pd(in + i - 3));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(12.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(39.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(56.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(39.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(12.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_sub_pd(sum, _mm256_loadu_pd(in + i + 3));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o4_w7_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p3 = _mm256_loadu_pd(x + i);
+        const __m256d p4 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 3);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e2), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w7(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o4_w7_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 6.0;
+    const __m512d vs = _mm512_set1_pd(s);
+    const __m512d sign = _mm512_set1_pd(-0.0);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_xor_pd(sign, _mm512_loadu_pd(in + i - 3));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(12.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(39.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(56.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(39.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(12.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_sub_pd(sum, _mm512_loadu_pd(in + i + 3));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w7(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o4_w7_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p3 = _mm512_loadu_pd(x + i);
+        const __m512d p4 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 3);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e2), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w7(x, in, out, i, end);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static const double DIFF_UNIFORM_O4_W9[9 * 9] = {
+    1069.0 / 80.0, -1316.0 / 15.0, 15289.0 / 60.0, -2144.0 / 5.0, 10993.0 / 24.0, -4772.0 / 15.0, 2803.0 / 20.0, -536.0 / 15.0, 967.0 / 240.0,
+    967.0 / 240.0, -229.0 / 10.0, 3439.0 / 60.0, -2509.0 / 30.0, 631.0 / 8.0, -1489.0 / 30.0, 1219.0 / 60.0, -49.0 / 10.0, 127.0 / 240.0,
+    127.0 / 240.0, -11.0 / 15.0, -77.0 / 20.0, 193.0 / 15.0, -407.0 / 24.0, 61.0 / 5.0, -311.0 / 60.0, 19.0 / 15.0, -11.0 / 80.0,
+    -11.0 / 80.0, 53.0 / 30.0, -341.0 / 60.0, 77.0 / 10.0, -107.0 / 24.0, 11.0 / 30.0, 13.0 / 20.0, -7.0 / 30.0, 7.0 / 240.0,
+    7.0 / 240.0, -2.0 / 5.0, 169.0 / 60.0, -122.0 / 15.0, 91.0 / 8.0, -122.0 / 15.0, 169.0 / 60.0, -2.0 / 5.0, 7.0 / 240.0,
+    7.0 / 240.0, -7.0 / 30.0, 13.0 / 20.0, 11.0 / 30.0, -107.0 / 24.0, 77.0 / 10.0, -341.0 / 60.0, 53.0 / 30.0, -11.0 / 80.0,
+    -11.0 / 80.0, 19.0 / 15.0, -311.0 / 60.0, 61.0 / 5.0, -407.0 / 24.0, 193.0 / 15.0, -77.0 / 20.0, -11.0 / 15.0, 127.0 / 240.0,
+    127.0 / 240.0, -49.0 / 10.0, 1219.0 / 60.0, -1489.0 / 30.0, 631.0 / 8.0, -2509.0 / 30.0, 3439.0 / 60.0, -229.0 / 10.0, 967.0 / 240.0,
+    967.0 / 240.0, -536.0 / 15.0, 2803.0 / 20.0, -4772.0 / 15.0, 10993.0 / 24.0, -2144.0 / 5.0, 15289.0 / 60.0, -1316.0 / 15.0, 1069.0 / 80.0,
+};
+
+static void diff_uniform_o4_w9(const double *restrict in,
+                               double *restrict out, size_t begin,
+                               size_t end, double scale) {
+    const double s = scale / 240.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = s * (7.0 * in[i - 4]
+                      - 96.0 * in[i - 3]
+                      + 676.0 * in[i - 2]
+                      - 1952.0 * in[i - 1]
+                      + 2730.0 * in[i]
+                      - 1952.0 * in[i + 1]
+                      + 676.0 * in[i + 2]
+                      - 96.0 * in[i + 3]
+                      + 7.0 * in[i + 4]);
+    }
+}
+
+static void diff_weights_o4_w9(double x0, const double *x,
+                               double *w) {
+    const double d0 = x0 - x[0];
+    const double d1 = x0 - x[1];
+    const double d2 = x0 - x[2];
+    const double d3 = x0 - x[3];
+    const double d4 = x0 - x[4];
+    const double d5 = x0 - x[5];
+    const double d6 = x0 - x[6];
+    const double d7 = x0 - x[7];
+    const double d8 = x0 - x[8];
+
+    double e0 = 1.0;
+    double e1, e2, e3, e4;
+
+    e1 = d1 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[0] = 24.0 * e4 / ((x[0] - x[1]) * (x[0] - x[2]) * (x[0] - x[3]) * (x[0] - x[4]) * (x[0] - x[5]) * (x[0] - x[6]) * (x[0] - x[7]) * (x[0] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d2 * e1;
+    e1 += d2 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[1] = 24.0 * e4 / ((x[1] - x[0]) * (x[1] - x[2]) * (x[1] - x[3]) * (x[1] - x[4]) * (x[1] - x[5]) * (x[1] - x[6]) * (x[1] - x[7]) * (x[1] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[2] = 24.0 * e4 / ((x[2] - x[0]) * (x[2] - x[1]) * (x[2] - x[3]) * (x[2] - x[4]) * (x[2] - x[5]) * (x[2] - x[6]) * (x[2] - x[7]) * (x[2] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[3] = 24.0 * e4 / ((x[3] - x[0]) * (x[3] - x[1]) * (x[3] - x[2]) * (x[3] - x[4]) * (x[3] - x[5]) * (x[3] - x[6]) * (x[3] - x[7]) * (x[3] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[4] = 24.0 * e4 / ((x[4] - x[0]) * (x[4] - x[1]) * (x[4] - x[2]) * (x[4] - x[3]) * (x[4] - x[5]) * (x[4] - x[6]) * (x[4] - x[7]) * (x[4] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[5] = 24.0 * e4 / ((x[5] - x[0]) * (x[5] - x[1]) * (x[5] - x[2]) * (x[5] - x[3]) * (x[5] - x[4]) * (x[5] - x[6]) * (x[5] - x[7]) * (x[5] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[6] = 24.0 * e4 / ((x[6] - x[0]) * (x[6] - x[1]) * (x[6] - x[2]) * (x[6] - x[3]) * (x[6] - x[4]) * (x[6] - x[5]) * (x[6] - x[7]) * (x[6] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d8 * e3;
+    e3 += d8 * e2;
+    e2 += d8 * e1;
+    e1 += d8 * e0;
+    w[7] = 24.0 * e4 / ((x[7] - x[0]) * (x[7] - x[1]) * (x[7] - x[2]) * (x[7] - x[3]) * (x[7] - x[4]) * (x[7] - x[5]) * (x[7] - x[6]) * (x[7] - x[8]));
+
+    e1 = d0 * e0;
+    e2 = d1 * e1;
+    e1 += d1 * e0;
+    e3 = d2 * e2;
+    e2 += d2 * e1;
+    e1 += d2 * e0;
+    e4 = d3 * e3;
+    e3 += d3 * e2;
+    e2 += d3 * e1;
+    e1 += d3 * e0;
+    e4 += d4 * e3;
+    e3 += d4 * e2;
+    e2 += d4 * e1;
+    e1 += d4 * e0;
+    e4 += d5 * e3;
+    e3 += d5 * e2;
+    e2 += d5 * e1;
+    e1 += d5 * e0;
+    e4 += d6 * e3;
+    e3 += d6 * e2;
+    e2 += d6 * e1;
+    e1 += d6 * e0;
+    e4 += d7 * e3;
+    e3 += d7 * e2;
+    e2 += d7 * e1;
+    e1 += d7 * e0;
+    w[8] = 24.0 * e4 / ((x[8] - x[0]) * (x[8] - x[1]) * (x[8] - x[2]) * (x[8] - x[3]) * (x[8] - x[4]) * (x[8] - x[5]) * (x[8] - x[6]) * (x[8] - x[7]));
+}
+
+static void diff_nonuniform_o4_w9(const double *restrict x,
+                                  const double *restrict in,
+                                  double *restrict out,
+                                  size_t begin, size_t end) {
+    double w[9];
+
+    for (size_t i = begin; i < end; ++i) {
+        diff_weights_o4_w9(x[i], x + i - 4, w);
+
+        double sum = 0;
+        sum += w[0] * in[i - 4];
+        sum += w[1] * in[i - 3];
+        sum += w[2] * in[i - 2];
+        sum += w[3] * in[i - 1];
+        sum += w[4] * in[i];
+        sum += w[5] * in[i + 1];
+        sum += w[6] * in[i + 2];
+        sum += w[7] * in[i + 3];
+        sum += w[8] * in[i + 4];
+
+        out[i] = sum;
+    }
+}
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+__attribute__((target("avx2"))) static void
+diff_uniform_o4_w9_avx2(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 240.0;
+    const __m256d vs = _mm256_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum;
+
+        sum = _mm256_mul_pd(_mm256_set1_pd(7.0), _mm256_loadu_pd(in + i - 4));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(96.0), _mm256_loadu_pd(in + i - 3)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(676.0), _mm256_loadu_pd(in + i - 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(1952.0), _mm256_loadu_pd(in + i - 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(2730.0), _mm256_loadu_pd(in + i)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(1952.0), _mm256_loadu_pd(in + i + 1)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(676.0), _mm256_loadu_pd(in + i + 2)));
+        sum = _mm256_sub_pd(sum, _mm256_mul_pd(_mm256_set1_pd(96.0), _mm256_loadu_pd(in + i + 3)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(7.0), _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx2"))) static void
+diff_nonuniform_o4_w9_avx2(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(x + i);
+        const __m256d p0 = _mm256_loadu_pd(x + i - 4);
+        const __m256d p1 = _mm256_loadu_pd(x + i - 3);
+        const __m256d p2 = _mm256_loadu_pd(x + i - 2);
+        const __m256d p3 = _mm256_loadu_pd(x + i - 1);
+        const __m256d p4 = _mm256_loadu_pd(x + i);
+        const __m256d p5 = _mm256_loadu_pd(x + i + 1);
+        const __m256d p6 = _mm256_loadu_pd(x + i + 2);
+        const __m256d p7 = _mm256_loadu_pd(x + i + 3);
+        const __m256d p8 = _mm256_loadu_pd(x + i + 4);
+
+        const __m256d d0 = _mm256_sub_pd(x0, p0);
+        const __m256d d1 = _mm256_sub_pd(x0, p1);
+        const __m256d d2 = _mm256_sub_pd(x0, p2);
+        const __m256d d3 = _mm256_sub_pd(x0, p3);
+        const __m256d d4 = _mm256_sub_pd(x0, p4);
+        const __m256d d5 = _mm256_sub_pd(x0, p5);
+        const __m256d d6 = _mm256_sub_pd(x0, p6);
+        const __m256d d7 = _mm256_sub_pd(x0, p7);
+        const __m256d d8 = _mm256_sub_pd(x0, p8);
+
+        const __m256d e0 = _mm256_set1_pd(1.0);
+        __m256d e1, e2, e3, e4;
+        __m256d w;
+        __m256d sum = _mm256_setzero_pd();
+
+        e1 = _mm256_mul_pd(d1, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p0, p1);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p0, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 4)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d2, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p1, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p1, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d3, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p2, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p2, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d4, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p3, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p3, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i - 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p4, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p4, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p5, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p5, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 1)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p6, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p7));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p6, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 2)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d8, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d8, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d8, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d8, e0));
+        w = _mm256_sub_pd(p7, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p7, p8));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 3)));
+
+        e1 = _mm256_mul_pd(d0, e0);
+        e2 = _mm256_mul_pd(d1, e1);
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d1, e0));
+        e3 = _mm256_mul_pd(d2, e2);
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d2, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d2, e0));
+        e4 = _mm256_mul_pd(d3, e3);
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d3, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d3, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d3, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d4, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d4, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d4, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d4, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d5, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d5, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d5, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d5, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d6, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d6, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d6, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d6, e0));
+        e4 = _mm256_add_pd(e4, _mm256_mul_pd(d7, e3));
+        e3 = _mm256_add_pd(e3, _mm256_mul_pd(d7, e2));
+        e2 = _mm256_add_pd(e2, _mm256_mul_pd(d7, e1));
+        e1 = _mm256_add_pd(e1, _mm256_mul_pd(d7, e0));
+        w = _mm256_sub_pd(p8, p0);
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p1));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p2));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p3));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p4));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p5));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p6));
+        w = _mm256_mul_pd(w, _mm256_sub_pd(p8, p7));
+        w = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(24.0), e4), w);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(w, _mm256_loadu_pd(in + i + 4)));
+
+        _mm256_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w9(x, in, out, i, end);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_uniform_o4_w9_avx512(const double *restrict in,
+                        double *restrict out, size_t begin,
+                        size_t end, double scale) {
+    const double s = scale / 240.0;
+    const __m512d vs = _mm512_set1_pd(s);
+
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m512d sum;
+
+        sum = _mm512_mul_pd(_mm512_set1_pd(7.0), _mm512_loadu_pd(in + i - 4));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(96.0), _mm512_loadu_pd(in + i - 3)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(676.0), _mm512_loadu_pd(in + i - 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(1952.0), _mm512_loadu_pd(in + i - 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(2730.0), _mm512_loadu_pd(in + i)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(1952.0), _mm512_loadu_pd(in + i + 1)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(676.0), _mm512_loadu_pd(in + i + 2)));
+        sum = _mm512_sub_pd(sum, _mm512_mul_pd(_mm512_set1_pd(96.0), _mm512_loadu_pd(in + i + 3)));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_set1_pd(7.0), _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(vs, sum));
+    }
+
+    diff_uniform_o4_w9(in, out, i, end, scale);
+}
+
+__attribute__((target("avx512f,avx512dq"))) static void
+diff_nonuniform_o4_w9_avx512(const double *restrict x,
+                           const double *restrict in,
+                           double *restrict out, size_t begin,
+                           size_t end) {
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        const __m512d x0 = _mm512_loadu_pd(x + i);
+        const __m512d p0 = _mm512_loadu_pd(x + i - 4);
+        const __m512d p1 = _mm512_loadu_pd(x + i - 3);
+        const __m512d p2 = _mm512_loadu_pd(x + i - 2);
+        const __m512d p3 = _mm512_loadu_pd(x + i - 1);
+        const __m512d p4 = _mm512_loadu_pd(x + i);
+        const __m512d p5 = _mm512_loadu_pd(x + i + 1);
+        const __m512d p6 = _mm512_loadu_pd(x + i + 2);
+        const __m512d p7 = _mm512_loadu_pd(x + i + 3);
+        const __m512d p8 = _mm512_loadu_pd(x + i + 4);
+
+        const __m512d d0 = _mm512_sub_pd(x0, p0);
+        const __m512d d1 = _mm512_sub_pd(x0, p1);
+        const __m512d d2 = _mm512_sub_pd(x0, p2);
+        const __m512d d3 = _mm512_sub_pd(x0, p3);
+        const __m512d d4 = _mm512_sub_pd(x0, p4);
+        const __m512d d5 = _mm512_sub_pd(x0, p5);
+        const __m512d d6 = _mm512_sub_pd(x0, p6);
+        const __m512d d7 = _mm512_sub_pd(x0, p7);
+        const __m512d d8 = _mm512_sub_pd(x0, p8);
+
+        const __m512d e0 = _mm512_set1_pd(1.0);
+        __m512d e1, e2, e3, e4;
+        __m512d w;
+        __m512d sum = _mm512_setzero_pd();
+
+        e1 = _mm512_mul_pd(d1, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p0, p1);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p0, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 4)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d2, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p1, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p1, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d3, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p2, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p2, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d4, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p3, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p3, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i - 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p4, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p4, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p5, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p5, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 1)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p6, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p7));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p6, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 2)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d8, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d8, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d8, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d8, e0));
+        w = _mm512_sub_pd(p7, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p7, p8));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 3)));
+
+        e1 = _mm512_mul_pd(d0, e0);
+        e2 = _mm512_mul_pd(d1, e1);
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d1, e0));
+        e3 = _mm512_mul_pd(d2, e2);
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d2, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d2, e0));
+        e4 = _mm512_mul_pd(d3, e3);
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d3, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d3, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d3, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d4, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d4, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d4, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d4, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d5, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d5, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d5, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d5, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d6, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d6, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d6, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d6, e0));
+        e4 = _mm512_add_pd(e4, _mm512_mul_pd(d7, e3));
+        e3 = _mm512_add_pd(e3, _mm512_mul_pd(d7, e2));
+        e2 = _mm512_add_pd(e2, _mm512_mul_pd(d7, e1));
+        e1 = _mm512_add_pd(e1, _mm512_mul_pd(d7, e0));
+        w = _mm512_sub_pd(p8, p0);
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p1));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p2));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p3));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p4));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p5));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p6));
+        w = _mm512_mul_pd(w, _mm512_sub_pd(p8, p7));
+        w = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(24.0), e4), w);
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(w, _mm512_loadu_pd(in + i + 4)));
+
+        _mm512_storeu_pd(out + i, sum);
+    }
+
+    diff_nonuniform_o4_w9(x, in, out, i, end);
+}
+
+#endif
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+#define DIFF_KERNELS(kind, o, w)                              \
+    {diff_##kind##_o##o##_w##w, diff_##kind##_o##o##_w##w##_avx2, \
+     diff_##kind##_o##o##_w##w##_avx512}
+#else
+#define DIFF_KERNELS(kind, o, w)                              \
+    {diff_##kind##_o##o##_w##w, diff_##kind##_o##o##_w##w,     \
+     diff_##kind##_o##o##_w##w}
+#endif
+
+static const diff_stencil DIFF_STENCILS[] = {
+    {1, 3, DIFF_UNIFORM_O1_W3, diff_weights_o1_w3,
+     DIFF_KERNELS(uniform, 1, 3),
+     DIFF_KERNELS(nonuniform, 1, 3)},
+    {1, 5, DIFF_UNIFORM_O1_W5, diff_weights_o1_w5,
+     DIFF_KERNELS(uniform, 1, 5),
+     DIFF_KERNELS(nonuniform, 1, 5)},
+    {1, 7, DIFF_UNIFORM_O1_W7, diff_weights_o1_w7,
+     DIFF_KERNELS(uniform, 1, 7),
+     DIFF_KERNELS(nonuniform, 1, 7)},
+    {1, 9, DIFF_UNIFORM_O1_W9, diff_weights_o1_w9,
+     DIFF_KERNELS(uniform, 1, 9),
+     DIFF_KERNELS(nonuniform, 1, 9)},
+    {2, 3, DIFF_UNIFORM_O2_W3, diff_weights_o2_w3,
+     DIFF_KERNELS(uniform, 2, 3),
+     DIFF_KERNELS(nonuniform, 2, 3)},
+    {2, 5, DIFF_UNIFORM_O2_W5, diff_weights_o2_w5,
+     DIFF_KERNELS(uniform, 2, 5),
+     DIFF_KERNELS(nonuniform, 2, 5)},
+    {2, 7, DIFF_UNIFORM_O2_W7, diff_weights_o2_w7,
+     DIFF_KERNELS(uniform, 2, 7),
+     DIFF_KERNELS(nonuniform, 2, 7)},
+    {2, 9, DIFF_UNIFORM_O2_W9, diff_weights_o2_w9,
+     DIFF_KERNELS(uniform, 2, 9),
+     DIFF_KERNELS(nonuniform, 2, 9)},
+    {3, 5, DIFF_UNIFORM_O3_W5, diff_weights_o3_w5,
+     DIFF_KERNELS(uniform, 3, 5),
+     DIFF_KERNELS(nonuniform, 3, 5)},
+    {3, 7, DIFF_UNIFORM_O3_W7, diff_weights_o3_w7,
+     DIFF_KERNELS(uniform, 3, 7),
+     DIFF_KERNELS(nonuniform, 3, 7)},
+    {3, 9, DIFF_UNIFORM_O3_W9, diff_weights_o3_w9,
+     DIFF_KERNELS(uniform, 3, 9),
+     DIFF_KERNELS(nonuniform, 3, 9)},
+    {4, 5, DIFF_UNIFORM_O4_W5, diff_weights_o4_w5,
+     DIFF_KERNELS(uniform, 4, 5),
+     DIFF_KERNELS(nonuniform, 4, 5)},
+    {4, 7, DIFF_UNIFORM_O4_W7, diff_weights_o4_w7,
+     DIFF_KERNELS(uniform, 4, 7),
+     DIFF_KERNELS(nonuniform, 4, 7)},
+    {4, 9, DIFF_UNIFORM_O4_W9, diff_weights_o4_w9,
+     DIFF_KERNELS(uniform, 4, 9),
+     DIFF_KERNELS(nonuniform, 4, 9)},
+};
+
+#undef DIFF_KERNELS
@@ -0,0 +1,607 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+
+/*
+ * Generates the finite difference kernels compiled into numerics_diff:
+ *
+ *     diff_kernels_gen > numerics_diff_kernels.h
+ *
+ * The order-th derivative at x0 of the polynomial interpolating f at
+ * x_0 .. x_{w-1} is sum_j c_j f(x_j) with
+ *
+ *     c_j = order! e_{w-1-order}(x0 - x_m : m != j) / prod_{m != j} (x_j - x_m)
+ *
+ * e_k being the k-th elementary symmetric polynomial.
+ * This is the difference expression DiffExpr / DiffExprAD of
+ * maxima/diff_quotientes.maxima derive, with sv = shift and
+ * sn = w - 1 - shift.
+ *
+ * On uniform grids, x_m = m and x0 = shift, thus all c_j are rationals,
+ * which are computed exactly and emitted as constants.
+ * For non-uniform grids, straight-line code computing the c_j is emitted.
+ *
+ * The interior kernels come in AVX2 and AVX-512 flavours as well.
+ * They perform the very same operations in the very same order as the
+ * scalar ones, lane by lane, thus give bitwise identical results.
+ */
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define MAX_ORDER 4
+#define MAX_WIDTH 9
+
+typedef struct {
+    int64_t num;
+    int64_t den;
+} rational;
+
+/*---------------------------------------------------------------------------*/
+
+static int64_t gcd(int64_t a, int64_t b) {
+    a = llabs(a);
+    b = llabs(b);
+
+    while (0 != b) {
+        int64_t r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int64_t factorial(unsigned n) {
+    int64_t f = 1;
+
+    for (unsigned i = 2; i <= n; ++i) {
+        f *= i;
+    }
+
+    return f;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static bool supported(unsigned order, unsigned width) {
+    return (1 <= order) && (order <= MAX_ORDER) && (1 == width % 2) &&
+           (order < width) && (width <= MAX_WIDTH);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Exact coefficient c_j of the uniform stencil evaluated at point shift
+ */
+static rational uniform_coefficient(unsigned order, unsigned width,
+                                    unsigned shift, unsigned j) {
+    const unsigned k_max = width - 1 - order;
+
+    /* e[k] = e_k of the d_m processed so far */
+    int64_t e[MAX_WIDTH] = {1};
+    int64_t den = 1;
+
+    for (unsigned m = 0; m < width; ++m) {
+        if (m == j) continue;
+
+        const int64_t d = (int64_t)shift - (int64_t)m;
+
+        for (unsigned k = k_max; k >= 1; --k) {
+            e[k] += d * e[k - 1];
+        }
+
+        den *= (int64_t)j - (int64_t)m;
+    }
+
+    rational c = {factorial(order) * e[k_max], den};
+
+    int64_t g = gcd(c.num, c.den);
+
+    if (0 == c.num) {
+        g = c.den;
+    }
+
+    c.num /= g;
+    c.den /= g;
+
+    if (c.den < 0) {
+        c.num = -c.num;
+        c.den = -c.den;
+    }
+
+    return c;
+}
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct {
+    const char *suffix;
+    const char *target;
+    const char *type;
+    /* Prefix of the intrinsics */
+    const char *mm;
+    unsigned lanes;
+} isa;
+
+static const isa ISAS[] = {
+    {"avx2", "avx2", "__m256d", "_mm256", 4},
+    {"avx512", "avx512f,avx512dq", "__m512d", "_mm512", 8},
+};
+
+#define NUM_ISAS (sizeof(ISAS) / sizeof(ISAS[0]))
+
+/*---------------------------------------------------------------------------*/
+
+static void print_offset(const char *array, int offset) {
+    if (0 == offset) {
+        printf("%s[i]", array);
+    } else {
+        printf("%s[i %c %d]", array, (offset < 0) ? '-' : '+', abs(offset));
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void pointer_string(char *buf, size_t size, const char *array,
+                           int offset) {
+    if (0 == offset) {
+        snprintf(buf, size, "%s + i", array);
+    } else {
+        snprintf(buf, size, "%s + i %c %d", array, (offset < 0) ? '-' : '+',
+                 abs(offset));
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void print_pointer(const char *array, int offset) {
+    char buf[32] = {0};
+    pointer_string(buf, sizeof(buf), array, offset);
+    printf("%s", buf);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Centered stencil as integer coefficients over the common denominator
+ */
+static int64_t centered_coefficients(unsigned order, unsigned width,
+                                     int64_t *coefficients) {
+    const unsigned shift = width / 2;
+
+    rational c[MAX_WIDTH];
+    int64_t lcm = 1;
+
+    for (unsigned j = 0; j < width; ++j) {
+        c[j] = uniform_coefficient(order, width, shift, j);
+        lcm = lcm / gcd(lcm, c[j].den) * c[j].den;
+    }
+
+    for (unsigned j = 0; j < width; ++j) {
+        coefficients[j] = c[j].num * (lcm / c[j].den);
+    }
+
+    return lcm;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void emit_uniform(unsigned order, unsigned width) {
+    printf("static const double DIFF_UNIFORM_O%u_W%u[%u * %u] = {\n", order,
+           width, width, width);
+
+    for (unsigned shift = 0; shift < width; ++shift) {
+        printf("   ");
+
+        for (unsigned j = 0; j < width; ++j) {
+            rational c = uniform_coefficient(order, width, shift, j);
+
+            if (1 == c.den) {
+                printf(" %" PRId64 ".0,", c.num);
+            } else {
+                printf(" %" PRId64 ".0 / %" PRId64 ".0,", c.num, c.den);
+            }
+        }
+
+        printf("\n");
+    }
+
+    printf("};\n\n");
+
+    /* Interior kernel: centered stencil over a common denominator */
+    const int shift = width / 2;
+
+    int64_t c[MAX_WIDTH];
+    const int64_t lcm = centered_coefficients(order, width, c);
+
+    printf("static void diff_uniform_o%u_w%u(const double *restrict in,\n"
+           "                               double *restrict out, size_t begin,\n"
+           "                               size_t end, double scale) {\n",
+           order, width);
+    printf("    const double s = scale / %" PRId64 ".0;\n\n", lcm);
+    printf("    for (size_t i = begin; i < end; ++i) {\n");
+    printf("        out[i] = s * (");
+
+    bool first = true;
+
+    for (unsigned j = 0; j < width; ++j) {
+        const int64_t n = c[j];
+
+        if (0 == n) continue;
+
+        if (!first) {
+            printf("\n                      ");
+        }
+
+        printf("%s", (n < 0) ? (first ? "-" : "- ") : (first ? "" : "+ "));
+
+        if ((1 != n) && (-1 != n)) {
+            printf("%" PRId64 ".0 * ", (n < 0) ? -n : n);
+        }
+
+        print_offset("in", (int)j - shift);
+        first = false;
+    }
+
+    printf(");\n    }\n}\n\n");
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void emit_uniform_vector(unsigned order, unsigned width,
+                                const isa *v) {
+    const int shift = width / 2;
+
+    int64_t c[MAX_WIDTH];
+    const int64_t lcm = centered_coefficients(order, width, c);
+
+    printf("__attribute__((target(\"%s\"))) static void\n"
+           "diff_uniform_o%u_w%u_%s(const double *restrict in,\n"
+           "                        double *restrict out, size_t begin,\n"
+           "                        size_t end, double scale) {\n",
+           v->target, order, width, v->suffix);
+    printf("    const double s = scale / %" PRId64 ".0;\n", lcm);
+    printf("    const %s vs = %s_set1_pd(s);\n", v->type, v->mm);
+
+    /* Negation just flips the sign bit */
+    unsigned first_j = 0;
+
+    while (0 == c[first_j]) ++first_j;
+
+    if (-1 == c[first_j]) {
+        printf("    const %s sign = %s_set1_pd(-0.0);\n", v->type, v->mm);
+    }
+
+    printf("\n    size_t i = begin;\n\n");
+    printf("    for (; i + %u <= end; i += %u) {\n", v->lanes, v->lanes);
+    printf("        %s sum;\n\n", v->type);
+
+    bool first = true;
+
+    for (unsigned j = 0; j < width; ++j) {
+        const int64_t n = c[j];
+
+        if (0 == n) continue;
+
+        const int64_t magnitude = (n < 0) ? -n : n;
+
+        /* The term, negated if it comes first, as -c x == (-c) x */
+        char term[128] = {0};
+        char load[64] = {0};
+
+        char pointer[32] = {0};
+        pointer_string(pointer, sizeof(pointer), "in", (int)j - shift);
+        snprintf(load, sizeof(load), "%s_loadu_pd(%s)", v->mm, pointer);
+
+        if (1 == magnitude) {
+            if (first && (n < 0)) {
+                snprintf(term, sizeof(term), "%s_xor_pd(sign, %s)", v->mm,
+                         load);
+            } else {
+                snprintf(term, sizeof(term), "%s", load);
+            }
+        } else {
+            snprintf(term, sizeof(term), "%s_mul_pd(%s_set1_pd(%" PRId64
+                     ".0), %s)",
+                     v->mm, v->mm, first ? n : magnitude, load);
+        }
+
+        if (first) {
+            printf("        sum = %s;\n", term);
+        } else {
+            printf("        sum = %s_%s_pd(sum, %s);\n", v->mm,
+                   (n < 0) ? "sub" : "add", term);
+        }
+
+        first = false;
+    }
+
+    printf("\n        %s_storeu_pd(out + i, %s_mul_pd(vs, sum));\n", v->mm,
+           v->mm);
+    printf("    }\n\n");
+    printf("    diff_uniform_o%u_w%u(in, out, i, end, scale);\n}\n\n", order,
+           width);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void emit_weights(unsigned order, unsigned width) {
+    const unsigned k_max = width - 1 - order;
+
+    printf("static void diff_weights_o%u_w%u(double x0, const double *x,\n"
+           "                               double *w) {\n",
+           order, width);
+
+    /* Only the denominators are left for the highest order */
+    for (unsigned m = 0; (0 < k_max) && (m < width); ++m) {
+        printf("    const double d%u = x0 - x[%u];\n", m, m);
+    }
+
+    printf("%s    double e0 = 1.0;\n", (0 < k_max) ? "\n" : "");
+
+    if (0 < k_max) {
+        printf("    double");
+
+        for (unsigned k = 1; k <= k_max; ++k) {
+            printf(" e%u%s", k, (k < k_max) ? "," : ";\n");
+        }
+    }
+
+    for (unsigned j = 0; j < width; ++j) {
+        printf("\n");
+
+        /* Number of d_m processed so far */
+        unsigned count = 0;
+
+        for (unsigned m = 0; m < width; ++m) {
+            if (m == j) continue;
+
+            const unsigned top = (count + 1 < k_max) ? count + 1 : k_max;
+
+            for (unsigned k = top; k >= 1; --k) {
+                if (k == count + 1) {
+                    printf("    e%u = d%u * e%u;\n", k, m, k - 1);
+                } else {
+                    printf("    e%u += d%u * e%u;\n", k, m, k - 1);
+                }
+            }
+
+            ++count;
+        }
+
+        printf("    w[%u] = %" PRId64 ".0 * e%u / (", j, factorial(order),
+               k_max);
+
+        bool first = true;
+
+        for (unsigned m = 0; m < width; ++m) {
+            if (m == j) continue;
+
+            printf("%s(x[%u] - x[%u])", first ? "" : " * ", j, m);
+            first = false;
+        }
+
+        printf(");\n");
+    }
+
+    printf("}\n\n");
+
+    /* Interior kernel, centered stencils */
+    const int shift = width / 2;
+
+    printf("static void diff_nonuniform_o%u_w%u(const double *restrict x,\n"
+           "                                  const double *restrict in,\n"
+           "                                  double *restrict out,\n"
+           "                                  size_t begin, size_t end) {\n",
+           order, width);
+    printf("    double w[%u];\n\n", width);
+    printf("    for (size_t i = begin; i < end; ++i) {\n");
+    printf("        diff_weights_o%u_w%u(x[i], ", order, width);
+    print_pointer("x", -shift);
+    printf(", w);\n\n");
+    printf("        double sum = 0;\n");
+
+    for (unsigned j = 0; j < width; ++j) {
+        printf("        sum += w[%u] * ", j);
+        print_offset("in", (int)j - shift);
+        printf(";\n");
+    }
+
+    printf("\n        out[i] = sum;\n    }\n}\n\n");
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Like the scalar kernel, with all of diff_weights inlined, lane by lane
+ */
+static void emit_nonuniform_vector(unsigned order, unsigned width,
+                                   const isa *v) {
+    const unsigned k_max = width - 1 - order;
+    const int shift = width / 2;
+
+    printf("__attribute__((target(\"%s\"))) static void\n"
+           "diff_nonuniform_o%u_w%u_%s(const double *restrict x,\n"
+           "                           const double *restrict in,\n"
+           "                           double *restrict out, size_t begin,\n"
+           "                           size_t end) {\n",
+           v->target, order, width, v->suffix);
+    printf("    size_t i = begin;\n\n");
+    printf("    for (; i + %u <= end; i += %u) {\n", v->lanes, v->lanes);
+
+    if (0 < k_max) {
+        printf("        const %s x0 = %s_loadu_pd(x + i);\n", v->type, v->mm);
+    }
+
+    for (unsigned m = 0; m < width; ++m) {
+        printf("        const %s p%u = %s_loadu_pd(", v->type, m, v->mm);
+        print_pointer("x", (int)m - shift);
+        printf(");\n");
+    }
+
+    printf("\n");
+
+    for (unsigned m = 0; (0 < k_max) && (m < width); ++m) {
+        printf("        const %s d%u = %s_sub_pd(x0, p%u);\n", v->type, m,
+               v->mm, m);
+    }
+
+    printf("%s        const %s e0 = %s_set1_pd(1.0);\n",
+           (0 < k_max) ? "\n" : "", v->type, v->mm);
+
+    if (0 < k_max) {
+        printf("        %s", v->type);
+
+        for (unsigned k = 1; k <= k_max; ++k) {
+            printf(" e%u%s", k, (k < k_max) ? "," : ";\n");
+        }
+    }
+
+    printf("        %s w;\n", v->type);
+    printf("        %s sum = %s_setzero_pd();\n", v->type, v->mm);
+
+    for (unsigned j = 0; j < width; ++j) {
+        printf("\n");
+
+        unsigned count = 0;
+
+        for (unsigned m = 0; m < width; ++m) {
+            if (m == j) continue;
+
+            const unsigned top = (count + 1 < k_max) ? count + 1 : k_max;
+
+            for (unsigned k = top; k >= 1; --k) {
+                if (k == count + 1) {
+                    printf("        e%u = %s_mul_pd(d%u, e%u);\n", k, v->mm, m,
+                           k - 1);
+                } else {
+                    printf("        e%u = %s_add_pd(e%u, %s_mul_pd(d%u, e%u));\n",
+                           k, v->mm, k, v->mm, m, k - 1);
+                }
+            }
+
+            ++count;
+        }
+
+        /* (x_j - x_a) * (x_j - x_b) * ..., left to right */
+        printf("        w = %s_sub_pd(p%u, p%u);\n", v->mm, j, (0 == j) ? 1 : 0);
+
+        for (unsigned m = (0 == j) ? 2 : 1; m < width; ++m) {
+            if (m == j) continue;
+
+            printf("        w = %s_mul_pd(w, %s_sub_pd(p%u, p%u));\n", v->mm,
+                   v->mm, j, m);
+        }
+
+        printf("        w = %s_div_pd(%s_mul_pd(%s_set1_pd(%" PRId64
+               ".0), e%u), w);\n",
+               v->mm, v->mm, v->mm, factorial(order), k_max);
+        printf("        sum = %s_add_pd(sum, %s_mul_pd(w, %s_loadu_pd(", v->mm,
+               v->mm, v->mm);
+        print_pointer("in", (int)j - shift);
+        printf(")));\n");
+    }
+
+    printf("\n        %s_storeu_pd(out + i, sum);\n", v->mm);
+    printf("    }\n\n");
+    printf("    diff_nonuniform_o%u_w%u(x, in, out, i, end);\n}\n\n", order,
+           width);
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    printf("/* Generated by diff_kernels_gen - do not edit */\n\n");
+
+    printf("#define DIFF_MAX_ORDER %u\n", MAX_ORDER);
+    printf("#define DIFF_MAX_WIDTH %u\n\n", MAX_WIDTH);
+
+    for (unsigned order = 1; order <= MAX_ORDER; ++order) {
+        for (unsigned width = 1; width <= MAX_WIDTH; ++width) {
+            if (!supported(order, width)) continue;
+
+            printf("/*------------------------------------------------------"
+                   "----------------------*/\n\n");
+            emit_uniform(order, width);
+            emit_weights(order, width);
+
+            printf("#ifdef NUMERICS_DIFF_X86_SIMD\n\n");
+
+            for (size_t i = 0; i < NUM_ISAS; ++i) {
+                emit_uniform_vector(order, width, ISAS + i);
+                emit_nonuniform_vector(order, width, ISAS + i);
+            }
+
+            printf("#endif\n\n");
+        }
+    }
+
+    /* Kernels by simd_level */
+    printf("#ifdef NUMERICS_DIFF_X86_SIMD\n"
+           "#define DIFF_KERNELS(kind, o, w)                              \\\n"
+           "    {diff_##kind##_o##o##_w##w, diff_##kind##_o##o##_w##w##_avx2, \\\n"
+           "     diff_##kind##_o##o##_w##w##_avx512}\n"
+           "#else\n"
+           "#define DIFF_KERNELS(kind, o, w)                              \\\n"
+           "    {diff_##kind##_o##o##_w##w, diff_##kind##_o##o##_w##w,     \\\n"
+           "     diff_##kind##_o##o##_w##w}\n"
+           "#endif\n\n");
+
+    printf("static const diff_stencil DIFF_STENCILS[] = {\n");
+
+    for (unsigned order = 1; order <= MAX_ORDER; ++order) {
+        for (unsigned width = 1; width <= MAX_WIDTH; ++width) {
+            if (!supported(order, width)) continue;
+
+            printf("    {%u, %u, DIFF_UNIFORM_O%u_W%u, diff_weights_o%u_w%u,\n"
+                   "     DIFF_KERNELS(uniform, %u, %u),\n"
+                   "     DIFF_KERNELS(nonuniform, %u, %u)},\n",
+                   order, width, order, width, order, width, order, width,
+                   order, width);
+        }
+    }
+
+    printf("};\n\n#undef DIFF_KERNELS\n");
+
+    return EXIT_SUCCESS;
+}
@@ -40,373 +40,6229 @@
 #include <assert.h>
 #include <limits.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NUMERICS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/*****************************************************************************
+                                   STATISTICS
+ ****************************************************************************/
+
+/*
+ * Without NUMERICS_STATS, all STATS_ macros expand to nothing, their
+ * arguments are never evaluated.
+ */
+
+#if defined(NUMERICS_STATS_CYCLES) && !defined(NUMERICS_STATS)
+#define NUMERICS_STATS
+#endif
+
+#ifdef NUMERICS_STATS
+
+static _Thread_local numerics_stats g_stats;
+
+#define STATS_ADD(counter, n) (g_stats.counter += (n))
+
+#else
+
+#define STATS_ADD(counter, n) ((void)0)
+
+#endif
+
+#ifdef NUMERICS_STATS_CYCLES
+
+#ifdef NUMERICS_X86_SIMD
+
+static uint64_t stats_ticks() { return __rdtsc(); }
+
+#else
+
+#include <time.h>
+
+static uint64_t stats_ticks() {
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+#endif
+
+#define STATS_TIMER_START() const uint64_t stats_start = stats_ticks()
+#define STATS_TIMER_STOP(timer)                                            \
+    (++g_stats.calls[timer], g_stats.ticks[timer] += stats_ticks() - stats_start)
+
+#elif defined(NUMERICS_STATS)
+
+#define STATS_TIMER_START() ((void)0)
+#define STATS_TIMER_STOP(timer) (++g_stats.calls[timer])
+
+#else
+
+#define STATS_TIMER_START() ((void)0)
+#define STATS_TIMER_STOP(timer) ((void)0)
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+bool numerics_stats_snapshot(numerics_stats *stats) {
+    assert(0 != stats);
+
+#ifdef NUMERICS_STATS
+
+    *stats = g_stats;
+    return true;
+
+#else
+
+    memset(stats, 0, sizeof(*stats));
+    return false;
+
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+
+void numerics_stats_reset() {
+#ifdef NUMERICS_STATS
+    memset(&g_stats, 0, sizeof(g_stats));
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+
+void numerics_stats_dump(FILE *out, const numerics_stats *stats) {
+    static const char *TIMER_NAMES[NUMERICS_TIMERS] = {
+        [NUMERICS_TIMER_IS_PRIME] = "is_prime",
+        [NUMERICS_TIMER_PASSES_RABIN_MILLER] = "passes_rabin_miller",
+        [NUMERICS_TIMER_NEXT_PRIME] = "next_prime",
+        [NUMERICS_TIMER_GREATEST_COMMON_DIVISOR] = "greatest_common_divisor",
+    };
+
+    numerics_stats own = {0};
+
+    if (0 == stats) {
+        numerics_stats_snapshot(&own);
+        stats = &own;
+    }
+
+    fprintf(out, "trial_divisions             %" PRIu64 "\n",
+            stats->trial_divisions);
+    fprintf(out, "modmuls                     %" PRIu64 "\n", stats->modmuls);
+    fprintf(out, "rabin_miller_rounds         %" PRIu64 "\n",
+            stats->rabin_miller_rounds);
+    fprintf(out, "sieve_hits                  %" PRIu64 "\n",
+            stats->sieve_hits);
+    fprintf(out, "gcds                        %" PRIu64 "\n", stats->gcds);
+
+    for (size_t i = 0; i < NUMERICS_TIMERS; ++i) {
+        fprintf(out, "%-23s calls %" PRIu64 " ticks %" PRIu64 "\n",
+                TIMER_NAMES[i], stats->calls[i], stats->ticks[i]);
+    }
+}
+
+/*****************************************************************************
+                                 VERY BASICS
+ ****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+
+int64_t llmax(int64_t n, int64_t m) {
+    if (n > m) return n;
+    return m;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int64_t llmin(int64_t n, int64_t m) {
+    if (n < m) return n;
+    return m;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Exact floor(sqrt(n)) - double precision alone is off for large n
+ */
+static uint64_t isqrt_u64(uint64_t n) {
+    uint64_t r = sqrt((double)n);
+
+    while ((r > UINT32_MAX) || (r * r > n)) {
+        --r;
+    }
+
+    while ((r < UINT32_MAX) && ((r + 1) * (r + 1) <= n)) {
+        ++r;
+    }
+
+    return r;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t mulmod_u64(uint64_t a, uint64_t b, uint64_t n) {
+    assert(0 != n);
+
+    STATS_ADD(modmuls, 1);
+
+    unsigned __int128 product = a;
+    product *= b;
+
+    return (uint64_t)(product % n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t modpow_u64(uint64_t a, uint64_t d, uint64_t n) {
+    assert(0 != n);
+
+    if (is_odd(n) && (1 < n)) {
+        /* Montgomery setup costs a single division, every multiplication
+         * afterwards is division free */
+        montgomery_ctx ctx = {0};
+        montgomery_init(&ctx, n);
+
+        return montgomery_from(
+            &ctx, montgomery_pow(&ctx, montgomery_to(&ctx, a), d));
+    }
+
+    /* Plain square-and-multiply, walking the exponent from its lowest bit.
+     * Every intermediate is reduced and smaller than n, thus the 128 bit
+     * products in mulmod_u64 never overflow */
+
+    uint64_t result = 1 % n;
+    uint64_t square = a % n;
+
+    while (0 != d) {
+        if (is_odd(d)) {
+            result = mulmod_u64(result, square, n);
+        }
+
+        d >>= 1;
+
+        if (0 != d) {
+            square = mulmod_u64(square, square, n);
+        }
+    }
+
+    return result;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool montgomery_init(montgomery_ctx *ctx, uint64_t n) {
+    if ((0 == ctx) || is_even(n) || (n < 3)) {
+        return false;
+    }
+
+    /* Newton iteration for the inverse of n mod 2^64:
+     * n * n = 1 mod 8 for odd n, each step doubles the number of
+     * correct bits: 3 -> 6 -> 12 -> 24 -> 48 -> 96 */
+    uint64_t inv = n;
+
+    for (size_t i = 0; i < 5; ++i) {
+        inv *= 2 - n * inv;
+    }
+
+    assert(1 == n * inv);
+
+    ctx->n = n;
+    ctx->n_inv = inv;
+
+    /* R mod n with R = 2^64 */
+    ctx->one = (0 - n) % n;
+    ctx->r2 = mulmod_u64(ctx->one, ctx->one, n);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Montgomery reduction: Returns t / R mod n for t < n * R
+ */
+static uint64_t montgomery_reduce(const montgomery_ctx *ctx,
+                                  unsigned __int128 t) {
+    uint64_t t_low = (uint64_t)t;
+    uint64_t t_high = (uint64_t)(t >> 64);
+
+    /* m * n = t mod R, thus t - m * n is divisible by R and the low words
+     * cancel out exactly */
+    uint64_t m = t_low * ctx->n_inv;
+    uint64_t mn_high = (uint64_t)(((unsigned __int128)m * ctx->n) >> 64);
+
+    uint64_t result = t_high - mn_high;
+
+    if (t_high < mn_high) {
+        result += ctx->n;
+    }
+
+    return result;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t montgomery_to(const montgomery_ctx *ctx, uint64_t a) {
+    return montgomery_mul(ctx, a % ctx->n, ctx->r2);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t montgomery_from(const montgomery_ctx *ctx, uint64_t a) {
+    return montgomery_reduce(ctx, a);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t montgomery_mul(const montgomery_ctx *ctx, uint64_t a, uint64_t b) {
+    STATS_ADD(modmuls, 1);
+    return montgomery_reduce(ctx, (unsigned __int128)a * b);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t montgomery_square(const montgomery_ctx *ctx, uint64_t a) {
+    STATS_ADD(modmuls, 1);
+    return montgomery_reduce(ctx, (unsigned __int128)a * a);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t montgomery_pow(const montgomery_ctx *ctx, uint64_t a, uint64_t d) {
+    uint64_t result = ctx->one;
+
+    while (0 != d) {
+        if (is_odd(d)) {
+            result = montgomery_mul(ctx, result, a);
+        }
+
+        d >>= 1;
+
+        if (0 != d) {
+            a = montgomery_square(ctx, a);
+        }
+    }
+
+    return result;
+}
+
+/*---------------------------------------------------------------------------*/
+
+uint64_t gcd_u64(uint64_t n, uint64_t m) {
+    /* Binary gcd by Stein:
+     * gcd(2n, 2m) = 2 gcd(n, m)
+     * gcd(2n, m) = gcd(n, m) for odd m
+     * gcd(n, m) = gcd(n, m - n) for odd n <= m, and m - n is even again.
+     * Gets along with shifts and subtractions only */
+
+    STATS_ADD(gcds, 1);
+
+    if (0 == n) return m;
+    if (0 == m) return n;
+
+    const int shift = __builtin_ctzll(n | m);
+    n >>= __builtin_ctzll(n);
+
+    while (0 != m) {
+        m >>= __builtin_ctzll(m);
+
+        if (n > m) {
+            uint64_t t = n;
+            n = m;
+            m = t;
+        }
+
+        m -= n;
+    }
+
+    return n << shift;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * |n| - works for INT64_MIN as well
+ */
+static uint64_t abs_u64(int64_t n) {
+    return (n < 0) ? (uint64_t)0 - (uint64_t)n : (uint64_t)n;
+}
+
+/*---------------------------------------------------------------------------*/
+
+uint64_t greatest_common_divisor(const int64_t n, const int64_t m) {
+    STATS_TIMER_START();
+    const uint64_t gcd = gcd_u64(abs_u64(n), abs_u64(m));
+    STATS_TIMER_STOP(NUMERICS_TIMER_GREATEST_COMMON_DIVISOR);
+
+    return gcd;
+}
+
+/*---------------------------------------------------------------------------*/
+
+uint64_t extended_greatest_common_divisor(const int64_t n, const int64_t m,
+                                          int64_t *x, int64_t *y) {
+    /* Euclid, keeping track of the coefficients:
+     * r0 = |n| * s0 + |m| * t0 and r1 = |n| * s1 + |m| * t1 throughout */
+    __int128 r0 = abs_u64(n);
+    __int128 r1 = abs_u64(m);
+    __int128 s0 = 1;
+    __int128 s1 = 0;
+    __int128 t0 = 0;
+    __int128 t1 = 1;
+
+    while (0 != r1) {
+        __int128 q = r0 / r1;
+        __int128 t = 0;
+
+        t = r0 - q * r1;
+        r0 = r1;
+        r1 = t;
+
+        t = s0 - q * s1;
+        s0 = s1;
+        s1 = t;
+
+        t = t0 - q * t1;
+        t0 = t1;
+        t1 = t;
+    }
+
+    if (n < 0) s0 = -s0;
+    if (m < 0) t0 = -t0;
+
+    if (0 != x) *x = (int64_t)s0;
+    if (0 != y) *y = (int64_t)t0;
+
+    return (uint64_t)r0;
+}
 
 /*---------------------------------------------------------------------------*/
 
-int64_t llmax(int64_t n, int64_t m) {
-    if (n > m) return n;
-    return m;
+uint64_t smallest_common_multiple(const int64_t n, const int64_t m) {
+    if ((0 == n) || (0 == m)) {
+        return 0;
+    }
+
+    const uint64_t n_abs = abs_u64(n);
+    const uint64_t m_abs = abs_u64(m);
+
+    /* Divide first - n / gcd * m cannot overflow unless the result does */
+    uint64_t result = 0;
+
+    if (__builtin_mul_overflow(n_abs / gcd_u64(n_abs, m_abs), m_abs,
+                               &result)) {
+        return 0;
+    }
+
+    return result;
+}
+
+/*---------------------------------------------------------------------------*/
+
+uint64_t modinv_u64(uint64_t a, uint64_t n) {
+    if (n < 2) {
+        return 0;
+    }
+
+    /* Extended Euclid, tracking the coefficient of a only.
+     * |t| <= n, hence 128 bit suffice for all n < 2^64 */
+    uint64_t r0 = n;
+    uint64_t r1 = a % n;
+    __int128 t0 = 0;
+    __int128 t1 = 1;
+
+    while (0 != r1) {
+        const uint64_t q = r0 / r1;
+        uint64_t r = r0 - q * r1;
+        r0 = r1;
+        r1 = r;
+
+        __int128 t = t0 - (__int128)q * t1;
+        t0 = t1;
+        t1 = t;
+    }
+
+    if (1 != r0) {
+        return 0;
+    }
+
+    if (t0 < 0) {
+        t0 += n;
+    }
+
+    return (uint64_t)t0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * a * b / R mod n, with R = 2^64 if ctx is given and R = 1 otherwise
+ */
+static uint64_t modinv_batch_mul(const montgomery_ctx *ctx, uint64_t n,
+                                 uint64_t a, uint64_t b) {
+    return (0 != ctx) ? montgomery_mul(ctx, a, b) : mulmod_u64(a, b, n);
+}
+
+/*---------------------------------------------------------------------------*/
+
+bool modinv_batch_u64(const uint64_t *values, uint64_t *inverses,
+                      size_t count, uint64_t n) {
+    if (n < 2) {
+        return false;
+    }
+
+    if (0 == count) {
+        return true;
+    }
+
+    montgomery_ctx mctx = {0};
+    const montgomery_ctx *ctx = montgomery_init(&mctx, n) ? &mctx : 0;
+
+    /* The backward pass needs the values after the prefix products have
+     * overwritten them */
+    uint64_t *copy = 0;
+
+    if (values == inverses) {
+        copy = malloc(count * sizeof(uint64_t));
+
+        if (0 == copy) {
+            return false;
+        }
+
+        memcpy(copy, values, count * sizeof(uint64_t));
+        values = copy;
+    }
+
+    /* No conversion into Montgomery form required: With P_i = v_0 ... v_i,
+     * the prefix products are p_i = P_i / R^i, and inv = P_i^-1 * R^i,
+     * hence inv * p_(i - 1) / R = v_i^-1 exactly */
+    inverses[0] = values[0] % n;
+
+    for (size_t i = 1; i < count; ++i) {
+        inverses[i] =
+            modinv_batch_mul(ctx, n, inverses[i - 1], values[i] % n);
+    }
+
+    uint64_t inv = modinv_u64(inverses[count - 1], n);
+    const bool invertible = (0 != inv);
+
+    if (invertible) {
+        for (size_t i = count - 1; 0 < i; --i) {
+            const uint64_t v = values[i] % n;
+            inverses[i] = modinv_batch_mul(ctx, n, inv, inverses[i - 1]);
+            inv = modinv_batch_mul(ctx, n, inv, v);
+        }
+
+        inverses[0] = inv;
+
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            inverses[i] = modinv_u64(values[i], n);
+        }
+    }
+
+    free(copy);
+
+    return invertible;
+}
+
+/*---------------------------------------------------------------------------*/
+
+bool crt_u64(const uint64_t *residues, const uint64_t *moduli, size_t count,
+             uint64_t *x, uint64_t *modulus) {
+    /* Invariant: r solves the first i congruences, modulo m = their lcm */
+    uint64_t r = 0;
+    uint64_t m = 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t mi = moduli[i];
+
+        if (0 == mi) {
+            return false;
+        }
+
+        const uint64_t ri = residues[i] % mi;
+        const uint64_t rm = r % mi;
+
+        /* r + m * k = ri mod mi  <=>  m * k = d mod mi */
+        const uint64_t d = (rm <= ri) ? ri - rm : ri + (mi - rm);
+        const uint64_t g = gcd_u64(m, mi);
+
+        if (0 != d % g) {
+            return false;
+        }
+
+        const uint64_t step = mi / g;
+        const unsigned __int128 lcm = (unsigned __int128)m * step;
+
+        if (UINT64_MAX < lcm) {
+            return false;
+        }
+
+        /* m / g is invertible mod mi / g */
+        uint64_t k = 0;
+
+        if (1 < step) {
+            k = mulmod_u64((d / g) % step, modinv_u64((m / g) % step, step),
+                           step);
+        }
+
+        /* k < step, thus r + m * k < m * step = lcm */
+        r = (uint64_t)(r + (unsigned __int128)m * k);
+        m = (uint64_t)lcm;
+    }
+
+    if (0 != x) *x = r;
+    if (0 != modulus) *modulus = m;
+
+    return true;
+}
+
+/*****************************************************************************
+                           MULTI PRECISION (internal)
+ ****************************************************************************/
+
+/*
+ * Just enough arbitrary precision arithmetic for the batch gcd:
+ * Non-negative numbers as arrays of 64 bit limbs, least significant first,
+ * with explicit sizes.
+ * Operands may carry leading zero limbs unless stated otherwise.
+ *
+ * Multiplication is Karatsuba above MP_KARATSUBA_LIMBS and a number
+ * theoretic transform above MP_NTT_LIMBS,
+ * division is Knuth's algorithm D for small operands and Barrett reduction
+ * with a reciprocal computed by Newton iteration above MP_BARRETT_LIMBS.
+ * Both thus cost O(n log n) for large numbers.
+ */
+
+#define MP_KARATSUBA_LIMBS 32
+#define MP_BARRETT_LIMBS 64
+#define MP_NTT_LIMBS 1024
+
+/*----------------------------------------------------------------------------*/
+
+static size_t mpn_size(const uint64_t *a, size_t n) {
+    while ((0 < n) && (0 == a[n - 1])) {
+        --n;
+    }
+
+    return n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int mpn_cmp(const uint64_t *a, size_t an, const uint64_t *b,
+                   size_t bn) {
+    an = mpn_size(a, an);
+    bn = mpn_size(b, bn);
+
+    if (an != bn) {
+        return (an < bn) ? -1 : 1;
+    }
+
+    for (size_t i = an; 0 < i; --i) {
+        if (a[i - 1] != b[i - 1]) {
+            return (a[i - 1] < b[i - 1]) ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a + b, an >= bn, r provides an limbs and may be a.
+ * Returns the carry.
+ */
+static uint64_t mpn_add(uint64_t *r, const uint64_t *a, size_t an,
+                        const uint64_t *b, size_t bn) {
+    assert(an >= bn);
+
+    uint64_t carry = 0;
+    size_t i = 0;
+
+    for (; i < bn; ++i) {
+        unsigned __int128 sum = (unsigned __int128)a[i] + b[i] + carry;
+
+        r[i] = (uint64_t)sum;
+        carry = (uint64_t)(sum >> 64);
+    }
+
+    /* Beyond b only the carry ripples on */
+    for (; (0 != carry) && (i < an); ++i) {
+        r[i] = a[i] + 1;
+        carry = (0 == r[i]);
+    }
+
+    if ((r != a) && (i < an)) {
+        memcpy(r + i, a + i, (an - i) * sizeof(uint64_t));
+    }
+
+    return carry;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a - b, an >= bn, r provides an limbs and may be a.
+ * Returns the borrow.
+ */
+static uint64_t mpn_sub(uint64_t *r, const uint64_t *a, size_t an,
+                        const uint64_t *b, size_t bn) {
+    assert(an >= bn);
+
+    uint64_t borrow = 0;
+    size_t i = 0;
+
+    for (; i < bn; ++i) {
+        uint64_t difference = a[i] - b[i] - borrow;
+
+        borrow = (a[i] < b[i]) || ((a[i] == b[i]) && borrow);
+        r[i] = difference;
+    }
+
+    for (; (0 != borrow) && (i < an); ++i) {
+        borrow = (0 == a[i]);
+        r[i] = a[i] - 1;
+    }
+
+    if ((r != a) && (i < an)) {
+        memcpy(r + i, a + i, (an - i) * sizeof(uint64_t));
+    }
+
+    return borrow;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a * b by schoolbook multiplication, r provides an + bn limbs
+ */
+static void mpn_mul_basecase(uint64_t *r, const uint64_t *a, size_t an,
+                             const uint64_t *b, size_t bn) {
+    memset(r, 0, (an + bn) * sizeof(uint64_t));
+
+    for (size_t i = 0; i < an; ++i) {
+        uint64_t carry = 0;
+
+        for (size_t j = 0; j < bn; ++j) {
+            unsigned __int128 t = (unsigned __int128)a[i] * b[j];
+            t += r[i + j];
+            t += carry;
+
+            r[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+
+        r[i + bn] = carry;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool mpn_mul(uint64_t *r, const uint64_t *a, size_t an,
+                    const uint64_t *b, size_t bn);
+
+/**
+ * r = a * b, both n limbs, r provides 2n limbs
+ */
+static bool mpn_karatsuba(uint64_t *r, const uint64_t *a, const uint64_t *b,
+                          size_t n) {
+    /* a = a1 B^h + a0, b = b1 B^h + b0
+     * a * b = z2 B^2h + (z1 - z2 - z0) B^h + z0
+     * with z1 = (a0 + a1) (b0 + b1), z0 = a0 b0, z2 = a1 b1 */
+    const size_t h = n / 2;
+    const size_t n1 = n - h;
+
+    uint64_t *t = malloc((4 * n1 + 4) * sizeof(uint64_t));
+
+    if (0 == t) {
+        return false;
+    }
+
+    uint64_t *sa = t;
+    uint64_t *sb = t + n1 + 1;
+    uint64_t *z1 = t + 2 * n1 + 2;
+
+    sa[n1] = mpn_add(sa, a + h, n1, a, h);
+    sb[n1] = mpn_add(sb, b + h, n1, b, h);
+
+    bool ok = mpn_mul(r, a, h, b, h) &&
+              mpn_mul(r + 2 * h, a + h, n1, b + h, n1) &&
+              mpn_mul(z1, sa, n1 + 1, sb, n1 + 1);
+
+    if (ok) {
+        /* z1 - z0 - z2 >= 0 and fits into 2 n1 + 1 limbs */
+        mpn_sub(z1, z1, 2 * n1 + 2, r, 2 * h);
+        mpn_sub(z1, z1, 2 * n1 + 2, r + 2 * h, 2 * n1);
+
+        size_t z1_size = mpn_size(z1, 2 * n1 + 2);
+
+        if (0 < z1_size) {
+            mpn_add(r + h, r + h, 2 * n - h, z1, z1_size);
+        }
+    }
+
+    free(t);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Number theoretic transforms modulo two primes c 2^k + 1 below 2^62.
+ * Operands are split into 32 bit digits, thus every coefficient of the
+ * convolution stays below 2^(64 + 33) and is recovered exactly from its
+ * residues by the chinese remainder theorem.
+ */
+
+#define MP_NTT_PRIMES_COUNT 2
+#define MP_NTT_MAX_LOG 38
+
+static const uint64_t MP_NTT_PRIMES[MP_NTT_PRIMES_COUNT] = {
+    0x3fff810000000001, /* 4194177 * 2^40 + 1 */
+    0x3fffca8000000001, /* 8388501 * 2^39 + 1 */
+};
+
+static const uint64_t MP_NTT_GENERATORS[MP_NTT_PRIMES_COUNT] = {5, 7};
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * In place transform of length n, roots[i] = w^i for i < n / 2
+ * in Montgomery form, w a primitive n-th root of unity.
+ * Coefficients are kept in ordinary form - multiplying by a Montgomery
+ * twiddle leaves them there.
+ */
+static void mp_ntt(uint64_t *a, size_t n, const uint64_t *roots,
+                   const montgomery_ctx *ctx) {
+    const uint64_t p = ctx->n;
+
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+
+        for (; 0 != (j & bit); bit >>= 1) {
+            j ^= bit;
+        }
+
+        j ^= bit;
+
+        if (i < j) {
+            uint64_t t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t stride = n / len;
+
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                uint64_t u = a[i + j];
+                uint64_t v =
+                    montgomery_mul(ctx, a[i + j + half], roots[j * stride]);
+
+                a[i + j] = (u + v >= p) ? u + v - p : u + v;
+                a[i + j + half] = (u >= v) ? u - v : u + p - v;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void mp_ntt_load(uint64_t *digits, size_t n, const uint64_t *a,
+                        size_t an) {
+    for (size_t i = 0; i < an; ++i) {
+        digits[2 * i] = (uint32_t)a[i];
+        digits[2 * i + 1] = a[i] >> 32;
+    }
+
+    memset(digits + 2 * an, 0, (n - 2 * an) * sizeof(uint64_t));
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Cyclic convolution of the digits of a and b modulo prime number k.
+ * Result goes to c.
+ */
+static void mp_ntt_convolve(uint64_t *c, uint64_t *fb, uint64_t *roots,
+                            size_t n, unsigned log, const uint64_t *a,
+                            size_t an, const uint64_t *b, size_t bn,
+                            size_t k) {
+    const uint64_t p = MP_NTT_PRIMES[k];
+
+    montgomery_ctx ctx = {0};
+    montgomery_init(&ctx, p);
+
+    uint64_t w = montgomery_pow(
+        &ctx, montgomery_to(&ctx, MP_NTT_GENERATORS[k]), (p - 1) >> log);
+
+    roots[0] = ctx.one;
+
+    for (size_t i = 1; i < n / 2; ++i) {
+        roots[i] = montgomery_mul(&ctx, roots[i - 1], w);
+    }
+
+    mp_ntt_load(c, n, a, an);
+    mp_ntt_load(fb, n, b, bn);
+    mp_ntt(c, n, roots, &ctx);
+    mp_ntt(fb, n, roots, &ctx);
+
+    for (size_t i = 0; i < n; ++i) {
+        c[i] = montgomery_mul(&ctx, c[i], fb[i]);
+    }
+
+    /* The inverse transform is the forward one with the indices reversed
+     * afterwards */
+    mp_ntt(c, n, roots, &ctx);
+
+    for (size_t i = 1; i < n - i; ++i) {
+        uint64_t t = c[i];
+        c[i] = c[n - i];
+        c[n - i] = t;
+    }
+
+    /* Undo the factor R^-1 of the pointwise products and divide by n:
+     * 1 / n = p - (p - 1) / n */
+    uint64_t scale = mulmod_u64(ctx.r2, p - ((p - 1) >> log), p);
+
+    for (size_t i = 0; i < n; ++i) {
+        c[i] = montgomery_mul(&ctx, c[i], scale);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a * b by number theoretic transform, r provides an + bn limbs
+ */
+static bool mpn_mul_ntt(uint64_t *r, const uint64_t *a, size_t an,
+                        const uint64_t *b, size_t bn) {
+    const size_t num_digits = 2 * (an + bn);
+
+    size_t n = 1;
+    unsigned log = 0;
+
+    for (; n < num_digits; n <<= 1) {
+        ++log;
+    }
+
+    if (MP_NTT_MAX_LOG < log) {
+        return false;
+    }
+
+    uint64_t *buffer = malloc((3 * n + n / 2) * sizeof(uint64_t));
+
+    if (0 == buffer) {
+        return false;
+    }
+
+    uint64_t *c1 = buffer;
+    uint64_t *c2 = buffer + n;
+    uint64_t *fb = buffer + 2 * n;
+    uint64_t *roots = buffer + 3 * n;
+
+    mp_ntt_convolve(c1, fb, roots, n, log, a, an, b, bn, 0);
+    mp_ntt_convolve(c2, fb, roots, n, log, a, an, b, bn, 1);
+
+    /* Garner: x = c1 + p1 ((c2 - c1) / p1 mod p2) */
+    const uint64_t p1 = MP_NTT_PRIMES[0];
+    const uint64_t p2 = MP_NTT_PRIMES[1];
+
+    montgomery_ctx ctx = {0};
+    montgomery_init(&ctx, p2);
+
+    const uint64_t p1_inv =
+        montgomery_to(&ctx, modpow_u64(p1 % p2, p2 - 2, p2));
+
+    unsigned __int128 carry = 0;
+
+    for (size_t i = 0; i < num_digits; ++i) {
+        uint64_t difference = (c2[i] >= c1[i]) ? c2[i] - c1[i]
+                                               : c2[i] + p2 - c1[i];
+        uint64_t t = montgomery_mul(&ctx, difference, p1_inv);
+
+        carry += (unsigned __int128)t * p1 + c1[i];
+
+        uint64_t digit = (uint32_t)carry;
+        carry >>= 32;
+
+        if (is_even(i)) {
+            r[i / 2] = digit;
+        } else {
+            r[i / 2] |= digit << 32;
+        }
+    }
+
+    assert(0 == carry);
+
+    free(buffer);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a * b, r provides an + bn limbs and must not overlap a or b
+ */
+static bool mpn_mul(uint64_t *r, const uint64_t *a, size_t an,
+                    const uint64_t *b, size_t bn) {
+    if (an < bn) {
+        const uint64_t *t = a;
+        a = b;
+        b = t;
+
+        size_t tn = an;
+        an = bn;
+        bn = tn;
+    }
+
+    if (0 == bn) {
+        memset(r, 0, an * sizeof(uint64_t));
+        return true;
+    }
+
+    if (bn < MP_KARATSUBA_LIMBS) {
+        mpn_mul_basecase(r, a, an, b, bn);
+        return true;
+    }
+
+    if (MP_NTT_LIMBS <= bn) {
+        return mpn_mul_ntt(r, a, an, b, bn);
+    }
+
+    if (an == bn) {
+        return mpn_karatsuba(r, a, b, an);
+    }
+
+    /* Unbalanced: multiply b with bn limb chunks of a */
+    uint64_t *t = malloc(2 * bn * sizeof(uint64_t));
+
+    if (0 == t) {
+        return false;
+    }
+
+    memset(r, 0, (an + bn) * sizeof(uint64_t));
+
+    bool ok = true;
+
+    for (size_t offset = 0; ok && (offset < an); offset += bn) {
+        size_t chunk = (an - offset < bn) ? an - offset : bn;
+
+        ok = mpn_mul(t, a + offset, chunk, b, bn);
+
+        if (ok) {
+            mpn_add(r + offset, r + offset, an + bn - offset, t, chunk + bn);
+        }
+    }
+
+    free(t);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Knuth, TAOCP Vol 2, 4.3.1, Algorithm D:
+ * q = a / m, r = a mod m.
+ * q provides an - mn + 1 limbs and may be 0, r provides mn limbs.
+ * m must not have leading zero limbs, an >= mn.
+ */
+static bool mpn_divrem_knuth(uint64_t *q, uint64_t *r, const uint64_t *a,
+                             size_t an, const uint64_t *m, size_t mn) {
+    assert((0 < mn) && (0 != m[mn - 1]) && (an >= mn));
+
+    if (0 != q) {
+        memset(q, 0, (an - mn + 1) * sizeof(uint64_t));
+    }
+
+    if (1 == mn) {
+        unsigned __int128 remainder = 0;
+
+        for (size_t i = an; 0 < i; --i) {
+            unsigned __int128 current = (remainder << 64) | a[i - 1];
+
+            if (0 != q) {
+                q[i - 1] = (uint64_t)(current / m[0]);
+            }
+
+            remainder = current % m[0];
+        }
+
+        r[0] = (uint64_t)remainder;
+        return true;
+    }
+
+    uint64_t *un = malloc((an + 1 + mn) * sizeof(uint64_t));
+
+    if (0 == un) {
+        return false;
+    }
+
+    uint64_t *vn = un + an + 1;
+
+    /* Normalize, such that the top bit of the divisor is set */
+    const int s = __builtin_clzll(m[mn - 1]);
+
+    for (size_t i = mn - 1; 0 < i; --i) {
+        vn[i] = (m[i] << s) | ((0 == s) ? 0 : m[i - 1] >> (64 - s));
+    }
+
+    vn[0] = m[0] << s;
+
+    un[an] = (0 == s) ? 0 : a[an - 1] >> (64 - s);
+
+    for (size_t i = an - 1; 0 < i; --i) {
+        un[i] = (a[i] << s) | ((0 == s) ? 0 : a[i - 1] >> (64 - s));
+    }
+
+    un[0] = a[0] << s;
+
+    const unsigned __int128 base = (unsigned __int128)1 << 64;
+
+    for (size_t j = an - mn + 1; 0 < j--;) {
+        unsigned __int128 numerator =
+            ((unsigned __int128)un[j + mn] << 64) | un[j + mn - 1];
+
+        unsigned __int128 qhat = numerator / vn[mn - 1];
+        unsigned __int128 rhat = numerator % vn[mn - 1];
+
+        while ((qhat >= base) ||
+               (qhat * vn[mn - 2] > ((rhat << 64) | un[j + mn - 2]))) {
+            --qhat;
+            rhat += vn[mn - 1];
+
+            if (rhat >= base) break;
+        }
+
+        /* un[j .. j + mn] -= qhat * vn */
+        uint64_t borrow = 0;
+        uint64_t carry = 0;
+
+        for (size_t i = 0; i < mn; ++i) {
+            unsigned __int128 product = qhat * vn[i] + carry;
+            carry = (uint64_t)(product >> 64);
+
+            uint64_t low = (uint64_t)product;
+            uint64_t before = un[i + j];
+
+            un[i + j] = before - low - borrow;
+            borrow = (before < low) || ((before == low) && borrow);
+        }
+
+        uint64_t before = un[j + mn];
+        un[j + mn] = before - carry - borrow;
+        bool negative = (before < carry) || ((before == carry) && borrow);
+
+        if (negative) {
+            /* qhat was one too large, add back */
+            --qhat;
+            un[j + mn] += mpn_add(un + j, un + j, mn, vn, mn);
+        }
+
+        if (0 != q) {
+            q[j] = (uint64_t)qhat;
+        }
+    }
+
+    for (size_t i = 0; i < mn; ++i) {
+        r[i] = (un[i] >> s) |
+               ((0 == s) ? 0 : un[i + 1] << (64 - s));
+    }
+
+    free(un);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * x = floor(B^2k / m), m having exactly k limbs.
+ * x provides k + 2 limbs.
+ *
+ * Computes the reciprocal of the upper half of m recursively,
+ * then does one Newton step x = x + x (B^2k - m x) / B^2k and corrects the
+ * last few units.
+ */
+static bool mpn_reciprocal(uint64_t *x, const uint64_t *m, size_t k) {
+    assert((0 < k) && (0 != m[k - 1]));
+
+    memset(x, 0, (k + 2) * sizeof(uint64_t));
+
+    /* B^2k */
+    uint64_t *power = calloc(2 * k + 1, sizeof(uint64_t));
+
+    if (0 == power) {
+        return false;
+    }
+
+    power[2 * k] = 1;
+
+    if (k < MP_BARRETT_LIMBS) {
+        bool ok = true;
+        uint64_t *r = malloc(k * sizeof(uint64_t));
+
+        ok = (0 != r) && mpn_divrem_knuth(x, r, power, 2 * k + 1, m, k);
+
+        free(r);
+        free(power);
+
+        return ok;
+    }
+
+    /* h > k / 2 + 2 makes the error of the Newton step less than 1 */
+    const size_t h = k / 2 + 3;
+    const size_t l = k - h;
+
+    uint64_t *t = calloc(6 * k + 8, sizeof(uint64_t));
+    uint64_t *e = calloc(4 * k + 8, sizeof(uint64_t));
+
+    bool ok = (0 != t) && (0 != e) && mpn_reciprocal(x + l, m + l, h);
+
+    /* x = floor(B^2h / m_high) B^l, thus x has at most k + 2 limbs */
+
+    ok = ok && mpn_mul(t, m, k, x, k + 2);
+
+    if (ok) {
+        const size_t tn = 2 * k + 2;
+        bool below = (0 >= mpn_cmp(t, tn, power, 2 * k + 1));
+
+        /* e = |B^2k - m x| */
+        if (below) {
+            mpn_sub(e, power, 2 * k + 1, t, 2 * k + 1);
+        } else {
+            mpn_sub(e, t, tn, power, 2 * k + 1);
+        }
+
+        size_t en = mpn_size(e, tn);
+
+        /* t = x e, correction = t / B^2k */
+        ok = mpn_mul(t, x, k + 2, e, en);
+
+        size_t correction_size = k + 2 + en;
+        uint64_t *correction = t + 2 * k;
+        size_t cn = (correction_size > 2 * k) ? correction_size - 2 * k : 0;
+
+        if (ok && below) {
+            mpn_add(x, x, k + 2, correction, (cn < k + 2) ? cn : k + 2);
+
+        } else if (ok) {
+            uint64_t one = 1;
+            mpn_sub(x, x, k + 2, correction, (cn < k + 2) ? cn : k + 2);
+            mpn_sub(x, x, k + 2, &one, 1);
+        }
+    }
+
+    /* Correct the last few units: Adjust x until 0 <= B^2k - m x < m */
+    ok = ok && mpn_mul(t, m, k, x, k + 2);
+
+    const uint64_t one = 1;
+
+    while (ok && (0 < mpn_cmp(t, 2 * k + 2, power, 2 * k + 1))) {
+        mpn_sub(x, x, k + 2, &one, 1);
+        mpn_sub(t, t, 2 * k + 2, m, k);
+    }
+
+    if (ok) {
+        mpn_sub(e, power, 2 * k + 1, t, 2 * k + 1);
+    }
+
+    while (ok && (0 <= mpn_cmp(e, 2 * k + 1, m, k))) {
+        mpn_add(x, x, k + 2, &one, 1);
+        mpn_sub(e, e, 2 * k + 1, m, k);
+    }
+
+    free(e);
+    free(t);
+    free(power);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Barrett reduction: r = a mod m for a < B^2k, m having exactly k limbs
+ * and mu = floor(B^2k / m) (k + 2 limbs).
+ * r provides k limbs.
+ */
+static bool mpn_barrett(uint64_t *r, const uint64_t *a, size_t an,
+                        const uint64_t *m, size_t k, const uint64_t *mu) {
+    assert(an <= 2 * k);
+
+    if (an < k) {
+        memset(r, 0, k * sizeof(uint64_t));
+        memcpy(r, a, an * sizeof(uint64_t));
+        return true;
+    }
+
+    /* q = floor(floor(a / B^(k - 1)) mu / B^(k + 1)) underestimates a / m
+     * by at most 2 */
+    const size_t q1n = an - (k - 1);
+    const size_t q2n = q1n + k + 2;
+
+    uint64_t *t = calloc(q2n + an + k + 4, sizeof(uint64_t));
+
+    if (0 == t) {
+        return false;
+    }
+
+    uint64_t *q2 = t;
+    uint64_t *qm = t + q2n;
+
+    bool ok = mpn_mul(q2, a + k - 1, q1n, mu, k + 2);
+
+    const uint64_t *q = q2 + k + 1;
+    const size_t qn = mpn_size(q, q2n - (k + 1));
+
+    ok = ok && mpn_mul(qm, q, qn, m, k);
+
+    if (ok) {
+        size_t qmn = mpn_size(qm, qn + k);
+
+        /* a - q m, fits into an limbs since q m <= a */
+        uint64_t *rest = q2;
+        memcpy(rest, a, an * sizeof(uint64_t));
+        mpn_sub(rest, rest, an, qm, qmn);
+
+        while (0 <= mpn_cmp(rest, an, m, k)) {
+            mpn_sub(rest, rest, an, m, k);
+        }
+
+        memcpy(r, rest, k * sizeof(uint64_t));
+    }
+
+    free(t);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * r = a mod m, m without leading zero limbs.
+ * r provides mn limbs.
+ */
+static bool mpn_mod(uint64_t *r, const uint64_t *a, size_t an,
+                    const uint64_t *m, size_t mn) {
+    an = mpn_size(a, an);
+
+    if (0 > mpn_cmp(a, an, m, mn)) {
+        memset(r, 0, mn * sizeof(uint64_t));
+        memcpy(r, a, an * sizeof(uint64_t));
+        return true;
+    }
+
+    if ((mn < MP_BARRETT_LIMBS) || (an - mn < MP_BARRETT_LIMBS)) {
+        return mpn_divrem_knuth(0, r, a, an, m, mn);
+    }
+
+    uint64_t *mu = malloc((mn + 2) * sizeof(uint64_t));
+    uint64_t *rest = malloc(an * sizeof(uint64_t));
+
+    bool ok = (0 != mu) && (0 != rest) && mpn_reciprocal(mu, m, mn);
+
+    if (ok) {
+        memcpy(rest, a, an * sizeof(uint64_t));
+    }
+
+    /* Reduce the top 2 mn limbs until everything fits below B^2mn */
+    size_t rest_size = an;
+
+    while (ok && (rest_size > 2 * mn)) {
+        size_t shift = rest_size - 2 * mn;
+
+        ok = mpn_barrett(r, rest + shift, 2 * mn, m, mn, mu);
+
+        if (ok) {
+            memcpy(rest + shift, r, mn * sizeof(uint64_t));
+            rest_size = mpn_size(rest, shift + mn);
+        }
+    }
+
+    if (ok) {
+        ok = mpn_barrett(r, rest, rest_size, m, mn, mu);
+    }
+
+    free(rest);
+    free(mu);
+
+    return ok;
+}
+
+/*****************************************************************************
+                                   BATCH GCD
+ ****************************************************************************/
+
+/*
+ * Bernstein's batch gcd:
+ *
+ * The product tree holds the values in its leaves and the product of its
+ * children in every inner node, the root being P, the product of all values.
+ * The remainder tree holds P mod node^2 in each node, computed top down from
+ * the remainder of the parent.
+ * For a leaf x, (P mod x^2) / x = (P / x) mod x, hence
+ * gcd(x, P / x) = gcd(x, (P mod x^2) / x).
+ */
+
+typedef struct {
+    uint64_t *limbs;
+    /* Node i spans limbs [offsets[i], offsets[i + 1]) */
+    size_t *offsets;
+    size_t count;
+} mp_tree_level;
+
+/*----------------------------------------------------------------------------*/
+
+static void mp_tree_level_free(mp_tree_level *level) {
+    free(level->limbs);
+    free(level->offsets);
+
+    level->limbs = 0;
+    level->offsets = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Allocates the offsets for a level of count nodes - the limbs are allocated
+ * once the offsets are filled in
+ */
+static bool mp_tree_level_alloc(mp_tree_level *level, size_t count) {
+    level->count = count;
+    level->limbs = 0;
+    level->offsets = calloc(count + 1, sizeof(size_t));
+
+    return 0 != level->offsets;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t *mp_tree_node(const mp_tree_level *level, size_t i,
+                              size_t *size) {
+    *size = level->offsets[i + 1] - level->offsets[i];
+    return level->limbs + level->offsets[i];
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Builds the next level of the product tree
+ */
+static bool product_tree_step(const mp_tree_level *lower,
+                              mp_tree_level *upper) {
+    if (!mp_tree_level_alloc(upper, (lower->count + 1) / 2)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < upper->count; ++i) {
+        size_t size = lower->offsets[2 * i + 1] - lower->offsets[2 * i];
+
+        if (2 * i + 1 < lower->count) {
+            size += lower->offsets[2 * i + 2] - lower->offsets[2 * i + 1];
+        }
+
+        upper->offsets[i + 1] = upper->offsets[i] + size;
+    }
+
+    upper->limbs = malloc(upper->offsets[upper->count] * sizeof(uint64_t));
+
+    bool ok = (0 != upper->limbs);
+
+    for (size_t i = 0; ok && (i < upper->count); ++i) {
+        size_t left_size = 0;
+        size_t node_size = 0;
+
+        const uint64_t *left = mp_tree_node(lower, 2 * i, &left_size);
+        uint64_t *node = mp_tree_node(upper, i, &node_size);
+
+        if (2 * i + 1 == lower->count) {
+            memcpy(node, left, left_size * sizeof(uint64_t));
+            continue;
+        }
+
+        size_t right_size = 0;
+        const uint64_t *right = mp_tree_node(lower, 2 * i + 1, &right_size);
+
+        left_size = mpn_size(left, left_size);
+        right_size = mpn_size(right, right_size);
+
+        memset(node, 0, node_size * sizeof(uint64_t));
+        ok = mpn_mul(node, left, left_size, right, right_size);
+    }
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Computes node mod node^2 for all nodes of level from the remainders of
+ * the parents
+ */
+static bool remainder_tree_step(const mp_tree_level *level,
+                                const mp_tree_level *parent_remainders,
+                                mp_tree_level *remainders) {
+    if (!mp_tree_level_alloc(remainders, level->count)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < level->count; ++i) {
+        remainders->offsets[i + 1] = remainders->offsets[i] +
+                                     2 * (level->offsets[i + 1] -
+                                          level->offsets[i]);
+    }
+
+    size_t total = remainders->offsets[level->count];
+
+    remainders->limbs = calloc(total, sizeof(uint64_t));
+    uint64_t *square = calloc(total, sizeof(uint64_t));
+
+    bool ok = (0 != remainders->limbs) && (0 != square);
+
+    for (size_t i = 0; ok && (i < level->count); ++i) {
+        size_t node_size = 0;
+        size_t parent_size = 0;
+        size_t remainder_size = 0;
+
+        const uint64_t *node = mp_tree_node(level, i, &node_size);
+        const uint64_t *parent =
+            mp_tree_node(parent_remainders, i / 2, &parent_size);
+        uint64_t *remainder = mp_tree_node(remainders, i, &remainder_size);
+
+        node_size = mpn_size(node, node_size);
+
+        ok = mpn_mul(square, node, node_size, node, node_size);
+
+        if (ok) {
+            size_t square_size = mpn_size(square, 2 * node_size);
+            ok = mpn_mod(remainder, parent, parent_size, square, square_size);
+        }
+    }
+
+    free(square);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool batch_gcd_u64(const uint64_t *values, size_t count, uint64_t *gcds) {
+    if ((0 == values) || (0 == gcds)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (0 == values[i]) return false;
+    }
+
+    if (count < 2) {
+        if (1 == count) gcds[0] = 1;
+        return true;
+    }
+
+    size_t num_levels = 1;
+
+    for (size_t n = count; n > 1; n = (n + 1) / 2) {
+        ++num_levels;
+    }
+
+    mp_tree_level *levels = calloc(num_levels, sizeof(mp_tree_level));
+
+    if (0 == levels) {
+        return false;
+    }
+
+    bool ok = mp_tree_level_alloc(levels, count);
+
+    if (ok) {
+        for (size_t i = 0; i < count; ++i) {
+            levels[0].offsets[i + 1] = i + 1;
+        }
+
+        levels[0].limbs = malloc(count * sizeof(uint64_t));
+        ok = (0 != levels[0].limbs);
+    }
+
+    if (ok) {
+        memcpy(levels[0].limbs, values, count * sizeof(uint64_t));
+    }
+
+    for (size_t l = 1; ok && (l < num_levels); ++l) {
+        ok = product_tree_step(levels + l - 1, levels + l);
+    }
+
+    /* Remainders, top down.
+     * The root remainder P mod P^2 is P itself, P > 1 */
+    mp_tree_level remainders = {0};
+    mp_tree_level root = levels[num_levels - 1];
+
+    for (size_t l = num_levels - 1; ok && (0 < l--);) {
+        mp_tree_level lower = {0};
+
+        ok = remainder_tree_step(levels + l,
+                                 (l == num_levels - 2) ? &root : &remainders,
+                                 &lower);
+
+        mp_tree_level_free(&remainders);
+        remainders = lower;
+
+        if (l + 1 < num_levels - 1) {
+            mp_tree_level_free(levels + l + 1);
+        }
+    }
+
+    for (size_t i = 0; ok && (i < count); ++i) {
+        size_t size = 0;
+        const uint64_t *remainder = mp_tree_node(&remainders, i, &size);
+
+        unsigned __int128 r = remainder[1];
+        r = (r << 64) | remainder[0];
+
+        gcds[i] = gcd_u64(values[i], (uint64_t)(r / values[i]));
+    }
+
+    mp_tree_level_free(&remainders);
+
+    for (size_t l = 0; l < num_levels; ++l) {
+        mp_tree_level_free(levels + l);
+    }
+
+    free(levels);
+
+    return ok;
+}
+
+/*****************************************************************************
+                                     PRIMES
+ ****************************************************************************/
+
+/*
+ * Trial division by a mod 30 wheel:
+ * Apart from 2, 3 and 5, only numbers coprime to 30 need to be tried, that
+ * is 8 out of every 30, one per spoke 1, 7, 11, 13, 17, 19, 23, 29.
+ */
+
+#define WHEEL_TRY(d)                                                       \
+    do {                                                                   \
+        const uint64_t candidate = (d);                                    \
+        if (candidate > limit) return 0;                                   \
+        STATS_ADD(trial_divisions, 1);                                     \
+        if (0 == n % candidate) return candidate;                          \
+    } while (0)
+
+/**
+ * Returns the smallest divisor d of n with from <= d <= limit, d coprime to
+ * 30, or 0 if there is none.
+ * from must be a multiple of 30.
+ */
+static uint64_t wheel_trial_division(uint64_t n, uint64_t from,
+                                     uint64_t limit) {
+    assert(0 == from % 30);
+
+    uint64_t base = from;
+
+    if (0 == base) {
+        /* Skip 1 */
+        WHEEL_TRY(7);
+        WHEEL_TRY(11);
+        WHEEL_TRY(13);
+        WHEEL_TRY(17);
+        WHEEL_TRY(19);
+        WHEEL_TRY(23);
+        WHEEL_TRY(29);
+        base = 30;
+    }
+
+    for (; base <= limit; base += 30) {
+        WHEEL_TRY(base + 1);
+        WHEEL_TRY(base + 7);
+        WHEEL_TRY(base + 11);
+        WHEEL_TRY(base + 13);
+        WHEEL_TRY(base + 17);
+        WHEEL_TRY(base + 19);
+        WHEEL_TRY(base + 23);
+        WHEEL_TRY(base + 29);
+    }
+
+    return 0;
+}
+
+#undef WHEEL_TRY
+
+/*----------------------------------------------------------------------------*/
+
+static bool is_prime_untimed(uint64_t p) {
+    if (p <= prime_table_limit()) {
+        STATS_ADD(sieve_hits, 1);
+        return prime_table_is_prime(p);
+    }
+
+    if ((2 == p) || (3 == p) || (5 == p)) {
+        return true;
+    }
+
+    if ((p < 2) || (0 == p % 2) || (0 == p % 3) || (0 == p % 5)) {
+        return false;
+    }
+
+    return 0 == wheel_trial_division(p, 0, isqrt_u64(p));
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool is_prime(uint64_t p) {
+    STATS_TIMER_START();
+    const bool prime = is_prime_untimed(p);
+    STATS_TIMER_STOP(NUMERICS_TIMER_IS_PRIME);
+
+    return prime;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool is_large_prime(uint64_t p) { return is_prime_u64(p); }
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Splits n - 1 into d * 2^s with d odd.
+ * n must be odd and greater than 2.
+ */
+static uint64_t split_off_twos(uint64_t n, uint64_t *d) {
+    assert(is_odd(n));
+    assert(2 < n);
+
+    uint64_t s = __builtin_ctzll(n - 1);
+    *d = (n - 1) >> s;
+
+    return s;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The actual rabin miller round:
+ * n odd, n - 1 = d * 2^s, d odd, ctx set up for n.
+ * Returns true if n is a strong probable prime to base a.
+ */
+static bool is_strong_probable_prime(const montgomery_ctx *ctx, uint64_t d,
+                                     uint64_t s, uint64_t a) {
+    /* All comparisons are done in montgomery form */
+    const uint64_t one = ctx->one;
+    const uint64_t minus_one = ctx->n - one;
+
+    STATS_ADD(rabin_miller_rounds, 1);
+
+    uint64_t m = montgomery_pow(ctx, montgomery_to(ctx, a), d);
+
+    if ((one == m) || (minus_one == m)) return true;
+
+    for (uint64_t r = 1; r < s; ++r) {
+        m = montgomery_square(ctx, m);
+
+        if (minus_one == m) return true;
+
+        // 1 without passing n - 1 first: found a nontrivial root of 1
+        if (one == m) return false;
+    }
+
+    return false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool passes_rabin_miller_untimed(uint64_t n) {
+    if (2 == n) {
+        return true;
+    }
+
+    if ((n < 2) || is_even(n)) {
+        return false;
+    }
+
+    if (3 == n) {
+        return true;
+    }
+
+    uint64_t d = 0;
+    uint64_t twos_exponent = split_off_twos(n, &d);
+
+    /* n - 1 is a square root of 1 and would pass for any n */
+    uint64_t a = random_range64(2, n - 2);
+    assert(2 <= a);
+    assert(a <= n - 2);
+
+    montgomery_ctx ctx = {0};
+    montgomery_init(&ctx, n);
+
+    return is_strong_probable_prime(&ctx, d, twos_exponent, a);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool passes_rabin_miller(uint64_t n) {
+    STATS_TIMER_START();
+    const bool passes = passes_rabin_miller_untimed(n);
+    STATS_TIMER_STOP(NUMERICS_TIMER_PASSES_RABIN_MILLER);
+
+    return passes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Small primes used to pre-filter candidates before doing any modular
+ * exponentiation - catches about 85% of the odd composites
+ */
+static const uint32_t SMALL_PRIMES[] = {3,  5,  7,  11, 13, 17, 19, 23,
+                                        29, 31, 37, 41, 43, 47, 53};
+
+#define SMALL_PRIMES_COUNT (sizeof(SMALL_PRIMES) / sizeof(SMALL_PRIMES[0]))
+
+/*
+ * Bases found by Jim Sinclair: If n passes the rabin miller test for all of
+ * these, n is prime for all n < 2^64.
+ */
+static const uint64_t DETERMINISTIC_RABIN_MILLER_BASES[] = {
+    2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+/*----------------------------------------------------------------------------*/
+
+bool is_prime_u64(uint64_t n) {
+    if (n < 2) {
+        return false;
+    }
+
+    if (is_even(n)) {
+        return 2 == n;
+    }
+
+    for (size_t i = 0; i < SMALL_PRIMES_COUNT; ++i) {
+        uint64_t p = SMALL_PRIMES[i];
+
+        if (n == p) return true;
+        STATS_ADD(trial_divisions, 1);
+        if (0 == n % p) return false;
+    }
+
+    // No factor <= 53, hence numbers < 59 * 59 must be prime
+    if (n < 59 * 59) {
+        return true;
+    }
+
+    uint64_t d = 0;
+    uint64_t s = split_off_twos(n, &d);
+
+    montgomery_ctx ctx = {0};
+    montgomery_init(&ctx, n);
+
+    for (size_t i = 0; i < sizeof(DETERMINISTIC_RABIN_MILLER_BASES) /
+                               sizeof(DETERMINISTIC_RABIN_MILLER_BASES[0]);
+         ++i) {
+        uint64_t a = DETERMINISTIC_RABIN_MILLER_BASES[i] % n;
+
+        // Base is a multiple of n and tells nothing
+        if (0 == a) continue;
+
+        if (!is_strong_probable_prime(&ctx, d, s, a)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t next_prime_untimed(const uint64_t n) {
+    if (n < prime_table_limit()) {
+        uint64_t prime = prime_table_next(n);
+
+        if (0 != prime) {
+            STATS_ADD(sieve_hits, 1);
+            return prime;
+        }
+    }
+
+    for (uint64_t num_to_check = 1 + n; num_to_check < UINT64_MAX;
+         ++num_to_check) {
+        if (is_prime(num_to_check)) {
+            return num_to_check;
+        }
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t next_prime(const uint64_t n) {
+    STATS_TIMER_START();
+    const uint64_t prime = next_prime_untimed(n);
+    STATS_TIMER_STOP(NUMERICS_TIMER_NEXT_PRIME);
+
+    return prime;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint32_t next_prime_factor(uint64_t n, uint32_t min_factor) {
+    uint64_t last_factor_to_check = isqrt_u64(n) + 1;
+
+    assert(UINT32_MAX >= last_factor_to_check);
+
+    if (0 == min_factor) {
+        min_factor = 1;
+    }
+
+    if (min_factor >= last_factor_to_check) {
+        return 0;
+    }
+
+    /* min_factor itself is checked, regardless of being prime */
+    STATS_ADD(trial_divisions, 1);
+
+    if (0 == n % min_factor) {
+        return min_factor;
+    }
+
+    prime_iterator primes = {0};
+
+    if (!prime_iterator_init(&primes, (uint64_t)min_factor + 1)) {
+        return 0;
+    }
+
+    uint32_t factor = 0;
+    uint64_t checked = min_factor;
+
+    for (uint64_t p = prime_iterator_next(&primes);
+         (0 != p) && (p < last_factor_to_check);
+         p = prime_iterator_next(&primes)) {
+        STATS_ADD(trial_divisions, 1);
+
+        if (0 == n % p) {
+            factor = (uint32_t)p;
+            break;
+        }
+
+        checked = p;
+    }
+
+    /* Without memory for the sieve window, go on prime by prime */
+    if (prime_iterator_failed(&primes)) {
+        for (uint64_t p = next_prime(checked); p < last_factor_to_check;
+             p = next_prime(p)) {
+            STATS_ADD(trial_divisions, 1);
+
+            if (0 == n % p) {
+                factor = (uint32_t)p;
+                break;
+            }
+        }
+    }
+
+    prime_iterator_free(&primes);
+
+    return factor;
+}
+
+/*****************************************************************************
+                                 FACTORIZATION
+ ****************************************************************************/
+
+/*
+ * Small factors are stripped by trial division,
+ * the remaining cofactor is split by Pollard's rho method in the variant of
+ * Brent until all parts are prime.
+ */
+
+/* Number of pseudo random steps between two gcds in pollard_brent */
+#define POLLARD_BRENT_BATCH 128
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * x^2 + c mod n, all in montgomery form
+ */
+static uint64_t pollard_step(const montgomery_ctx *ctx, uint64_t x,
+                             uint64_t c) {
+    uint64_t y = montgomery_square(ctx, x);
+
+    /* y + c < 2n might not fit into 64 bits */
+    if (y >= ctx->n - c) {
+        return y - (ctx->n - c);
+    }
+
+    return y + c;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns a nontrivial factor of n.
+ * n must be odd and composite.
+ *
+ * Brent's cycle detection, the differences are multiplied up in montgomery
+ * form and only every POLLARD_BRENT_BATCH steps a gcd is taken.
+ * Since R is coprime to n, gcd(xR mod n, n) = gcd(x, n).
+ */
+static uint64_t pollard_brent(uint64_t n) {
+    assert(is_odd(n));
+
+    montgomery_ctx ctx = {0};
+    montgomery_init(&ctx, n);
+
+    for (uint64_t c_plain = 1;; ++c_plain) {
+        const uint64_t c = montgomery_to(&ctx, c_plain);
+
+        uint64_t y = montgomery_to(&ctx, 2);
+        uint64_t x = y;
+        uint64_t ys = y;
+        uint64_t q = ctx.one;
+        uint64_t g = 1;
+
+        for (uint64_t r = 1; 1 == g; r *= 2) {
+            x = y;
+
+            for (uint64_t i = 0; i < r; ++i) {
+                y = pollard_step(&ctx, y, c);
+            }
+
+            for (uint64_t k = 0; (k < r) && (1 == g);
+                 k += POLLARD_BRENT_BATCH) {
+                ys = y;
+
+                for (uint64_t i = 0; (i < POLLARD_BRENT_BATCH) && (i < r - k);
+                     ++i) {
+                    y = pollard_step(&ctx, y, c);
+                    q = montgomery_mul(&ctx, q, (x > y) ? x - y : y - x);
+                }
+
+                g = gcd_u64(q, n);
+            }
+        }
+
+        if (n == g) {
+            /* The batch overshot - redo it step by step */
+            do {
+                ys = pollard_step(&ctx, ys, c);
+                g = gcd_u64((x > ys) ? x - ys : ys - x, n);
+            } while (1 == g);
+        }
+
+        if (n != g) {
+            return g;
+        }
+
+        /* Cycle closed without finding a factor: try another polynomial */
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* Factors up to this are found by trial division, larger ones by Pollard */
+#define FACTORIZE_TRIAL_LIMIT 1024
+
+/**
+ * Adds prime with exponent to the ascending list of factors
+ */
+static size_t add_factor(uint64_t prime, uint32_t exponent, uint64_t *factors,
+                         uint32_t *exponents, size_t num_factors) {
+    size_t i = 0;
+
+    while ((i < num_factors) && (factors[i] < prime)) {
+        ++i;
+    }
+
+    if ((i < num_factors) && (factors[i] == prime)) {
+        exponents[i] += exponent;
+        return num_factors;
+    }
+
+    assert(num_factors < FACTORIZE_MAX_FACTORS);
+
+    memmove(factors + i + 1, factors + i,
+            (num_factors - i) * sizeof(factors[0]));
+    memmove(exponents + i + 1, exponents + i,
+            (num_factors - i) * sizeof(exponents[0]));
+
+    factors[i] = prime;
+    exponents[i] = exponent;
+
+    return num_factors + 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+size_t factorize_u64(uint64_t n, uint64_t *factors, uint32_t *exponents) {
+    if ((n < 2) || (0 == factors) || (0 == exponents)) {
+        return 0;
+    }
+
+    size_t num_factors = 0;
+
+    if (is_even(n)) {
+        uint32_t twos = __builtin_ctzll(n);
+        n >>= twos;
+        num_factors = add_factor(2, twos, factors, exponents, num_factors);
+    }
+
+    for (uint64_t p = 3; p <= 5; p += 2) {
+        uint32_t exponent = 0;
+
+        while (0 == n % p) {
+            n /= p;
+            ++exponent;
+        }
+
+        if (0 != exponent) {
+            num_factors = add_factor(p, exponent, factors, exponents,
+                                     num_factors);
+        }
+    }
+
+    /* Strip small factors by the wheel, which also settles n entirely if it
+     * has at most one factor beyond FACTORIZE_TRIAL_LIMIT */
+    uint64_t root = isqrt_u64(n);
+    uint64_t from = 0;
+
+    for (;;) {
+        const uint64_t limit =
+            (root < FACTORIZE_TRIAL_LIMIT) ? root : FACTORIZE_TRIAL_LIMIT;
+        const uint64_t p = wheel_trial_division(n, from, limit);
+
+        if (0 == p) break;
+
+        uint32_t exponent = 0;
+
+        while (0 == n % p) {
+            n /= p;
+            ++exponent;
+        }
+
+        num_factors = add_factor(p, exponent, factors, exponents, num_factors);
+
+        root = isqrt_u64(n);
+        from = p - p % 30;
+    }
+
+    if ((1 < n) && (root <= FACTORIZE_TRIAL_LIMIT)) {
+        return add_factor(n, 1, factors, exponents, num_factors);
+    }
+
+    /* Cofactors still to be split.
+     * Every split at least halves them, thus 64 entries suffice */
+    uint64_t pending[64] = {n};
+    size_t num_pending = (1 < n) ? 1 : 0;
+
+    while (0 < num_pending) {
+        uint64_t m = pending[--num_pending];
+
+        if (is_prime_u64(m)) {
+            num_factors = add_factor(m, 1, factors, exponents, num_factors);
+            continue;
+        }
+
+        uint64_t d = pollard_brent(m);
+
+        pending[num_pending++] = d;
+        pending[num_pending++] = m / d;
+    }
+
+    return num_factors;
+}
+
+/*****************************************************************************
+                                  PRIME TABLE
+ ****************************************************************************/
+
+/*
+ * Bit packed sieve of Eratosthenes, compressed by a mod 30 wheel:
+ *
+ * Apart from 2, 3 and 5, all primes are coprime to 30, thus leave one of the
+ * 8 residues 1, 7, 11, 13, 17, 19, 23, 29 modulo 30.
+ * Byte k of the table holds one bit for each number 30k + WHEEL_RESIDUES[j],
+ * hence 30 numbers fit into one byte.
+ *
+ * For counting, the number of primes in front of each block of
+ * PRIME_TABLE_BLOCK_BYTES bytes is stored as well.
+ */
+
+#define PRIME_TABLE_BLOCK_BYTES 512
+
+/* Number of bytes sieved in one go while building - fits into L1 */
+#define PRIME_TABLE_SEGMENT_BYTES (32 * 1024)
+
+static const uint8_t WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+/* Bit for residue r mod 30, 0 if r is not coprime to 30 */
+static const uint8_t WHEEL_BIT[30] = {
+    0, 1 << 0, 0, 0, 0, 0, 0, 1 << 1, 0, 0, 0, 1 << 2, 0, 1 << 3, 0,
+    0, 0, 1 << 4, 0, 1 << 5, 0, 0, 0, 1 << 6, 0, 0, 0, 0, 0, 1 << 7};
+
+/* Distance from residue r mod 30 to the next residue coprime to 30 */
+static const uint8_t WHEEL_STEP[30] = {1, 6, 5, 4, 3, 2, 1, 4, 3, 2,
+                                       1, 2, 1, 4, 3, 2, 1, 2, 1, 4,
+                                       3, 2, 1, 6, 5, 4, 3, 2, 1, 2};
+
+static struct {
+    /* Highest number covered, 0 if there is no table */
+    uint64_t limit;
+    uint64_t bytes;
+    uint64_t blocks;
+    const uint8_t *bits;
+    /* counts[b]: number of primes >= 7 in bytes [0, b * BLOCK_BYTES) */
+    const uint64_t *counts;
+
+    void *memory;
+    /* Size of the mapping if loaded from a file, 0 if memory is malloc'ed */
+    size_t mapped_bytes;
+
+} g_prime_table = {0};
+
+/*
+ * On disk, the table is stored just as it is kept in memory, hence can be
+ * mapped as it is:
+ *
+ *   prime_table_header
+ *   counts    (blocks + 1) uint64_t
+ *   bits      bytes uint8_t
+ *
+ * All numbers are in host byte order, which the header records.
+ * Any change to the layout must bump PRIME_TABLE_VERSION.
+ */
+
+#define PRIME_TABLE_MAGIC "NUMPRIME"
+#define PRIME_TABLE_VERSION 1
+#define PRIME_TABLE_BYTE_ORDER 0x0102030405060708ull
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    uint64_t byte_order;
+    uint64_t limit;
+    uint64_t bytes;
+    uint64_t blocks;
+    uint64_t block_bytes;
+    /* Number of primes <= limit */
+    uint64_t num_primes;
+} prime_table_header;
+
+_Static_assert(0 == sizeof(prime_table_header) % sizeof(uint64_t),
+               "counts must be aligned within the file");
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns all primes 7 <= p <= max by a plain sieve.
+ * Only used for getting the sieving primes, i.e. max is small.
+ */
+static uint32_t *small_wheel_primes(uint64_t max, size_t *num_primes) {
+    *num_primes = 0;
+
+    bool *composite = calloc(max + 1, sizeof(bool));
+    uint32_t *primes = calloc(max / 2 + 1, sizeof(uint32_t));
+
+    if ((0 == composite) || (0 == primes)) {
+        free(composite);
+        free(primes);
+        return 0;
+    }
+
+    for (uint64_t i = 3; i <= max; i += 2) {
+        if (composite[i]) continue;
+
+        if (i >= 7) {
+            primes[(*num_primes)++] = i;
+        }
+
+        for (uint64_t j = i * i; j <= max; j += 2 * i) {
+            composite[j] = true;
+        }
+    }
+
+    free(composite);
+    return primes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Clears all multiples m = p * q of the sieving primes in bytes
+ * [first_byte, first_byte + num_bytes) with q >= p coprime to 30
+ */
+static void sieve_wheel_segment(uint8_t *bits, uint64_t first_byte,
+                                uint64_t num_bytes, const uint32_t *primes,
+                                size_t num_primes) {
+    const uint64_t lo = 30 * first_byte;
+    const uint64_t hi = lo + 30 * num_bytes;
+
+    for (size_t i = 0; i < num_primes; ++i) {
+        const uint64_t p = primes[i];
+
+        if (p * p >= hi) break;
+
+        uint64_t q = (lo + p - 1) / p;
+
+        if (q < p) q = p;
+
+        q += (0 == WHEEL_BIT[q % 30]) ? WHEEL_STEP[q % 30] : 0;
+
+        for (uint64_t m = p * q; m < hi; m = p * q) {
+            bits[m / 30 - first_byte] &= ~WHEEL_BIT[m % 30];
+            q += WHEEL_STEP[q % 30];
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_table_init(uint64_t limit) {
+    prime_table_free();
+
+    if (limit < 2) {
+        return true;
+    }
+
+    uint64_t bytes = limit / 30 + 1;
+    uint64_t blocks = bytes / PRIME_TABLE_BLOCK_BYTES + 1;
+
+    if (bytes > SIZE_MAX / 2) {
+        return false;
+    }
+
+    /* counts and bits share one allocation, counts first for alignment */
+    uint64_t *counts = malloc((blocks + 1) * sizeof(uint64_t) + bytes);
+
+    size_t num_primes = 0;
+    uint32_t *primes = small_wheel_primes(isqrt_u64(limit), &num_primes);
+
+    if ((0 == counts) || (0 == primes)) {
+        free(counts);
+        free(primes);
+        return false;
+    }
+
+    uint8_t *bits = (uint8_t *)(counts + blocks + 1);
+
+    memset(bits, 0xff, bytes);
+
+    for (uint64_t first = 0; first < bytes;
+         first += PRIME_TABLE_SEGMENT_BYTES) {
+        uint64_t num_bytes = bytes - first;
+
+        if (num_bytes > PRIME_TABLE_SEGMENT_BYTES) {
+            num_bytes = PRIME_TABLE_SEGMENT_BYTES;
+        }
+
+        sieve_wheel_segment(bits + first, first, num_bytes, primes,
+                            num_primes);
+    }
+
+    free(primes);
+
+    /* 1 is no prime, and there is nothing beyond limit */
+    bits[0] &= ~WHEEL_BIT[1];
+
+    for (size_t j = 0; j < 8; ++j) {
+        if (30 * (bytes - 1) + WHEEL_RESIDUES[j] > limit) {
+            bits[bytes - 1] &= ~(1 << j);
+        }
+    }
+
+    uint64_t count = 0;
+
+    for (uint64_t b = 0; b < blocks; ++b) {
+        counts[b] = count;
+
+        for (uint64_t i = b * PRIME_TABLE_BLOCK_BYTES;
+             (i < bytes) && (i < (b + 1) * PRIME_TABLE_BLOCK_BYTES); ++i) {
+            count += __builtin_popcount(bits[i]);
+        }
+    }
+
+    counts[blocks] = count;
+
+    g_prime_table.limit = limit;
+    g_prime_table.bytes = bytes;
+    g_prime_table.blocks = blocks;
+    g_prime_table.bits = bits;
+    g_prime_table.counts = counts;
+    g_prime_table.memory = counts;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void prime_table_free() {
+    if (0 != g_prime_table.mapped_bytes) {
+        munmap(g_prime_table.memory, g_prime_table.mapped_bytes);
+    } else {
+        free(g_prime_table.memory);
+    }
+
+    memset(&g_prime_table, 0, sizeof(g_prime_table));
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Number of primes <= limit beyond the bitmap, i.e. 2, 3, 5
+ */
+static uint64_t prime_table_primes_below_7(uint64_t limit) {
+    return (limit >= 2) + (limit >= 3) + (limit >= 5);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_table_save(const char *path) {
+    if ((0 == g_prime_table.limit) || (0 == path)) {
+        return false;
+    }
+
+    prime_table_header header = {
+        .version = PRIME_TABLE_VERSION,
+        .header_bytes = sizeof(prime_table_header),
+        .byte_order = PRIME_TABLE_BYTE_ORDER,
+        .limit = g_prime_table.limit,
+        .bytes = g_prime_table.bytes,
+        .blocks = g_prime_table.blocks,
+        .block_bytes = PRIME_TABLE_BLOCK_BYTES,
+        .num_primes = g_prime_table.counts[g_prime_table.blocks] +
+                      prime_table_primes_below_7(g_prime_table.limit),
+    };
+
+    memcpy(header.magic, PRIME_TABLE_MAGIC, sizeof(header.magic));
+
+    /* Written aside and renamed, thus processes that mapped a previous
+     * version of path keep seeing a consistent table */
+    size_t path_len = strlen(path);
+    char *temp_path = malloc(path_len + 5);
+
+    if (0 == temp_path) {
+        return false;
+    }
+
+    memcpy(temp_path, path, path_len);
+    memcpy(temp_path + path_len, ".tmp", 5);
+
+    FILE *file = fopen(temp_path, "wb");
+
+    if (0 == file) {
+        free(temp_path);
+        return false;
+    }
+
+    const size_t num_counts = g_prime_table.blocks + 1;
+
+    bool ok =
+        (1 == fwrite(&header, sizeof(header), 1, file)) &&
+        (num_counts == fwrite(g_prime_table.counts, sizeof(uint64_t),
+                              num_counts, file)) &&
+        (g_prime_table.bytes ==
+         fwrite(g_prime_table.bits, 1, g_prime_table.bytes, file));
+
+    ok = (0 == fclose(file)) && ok;
+    ok = ok && (0 == rename(temp_path, path));
+
+    if (!ok) {
+        remove(temp_path);
+    }
+
+    free(temp_path);
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Checks whether the mapped file holds a table this version can use
+ */
+static bool prime_table_header_valid(const void *memory, size_t size) {
+    if (size < sizeof(prime_table_header)) {
+        return false;
+    }
+
+    const prime_table_header *header = memory;
+
+    if ((0 != memcmp(header->magic, PRIME_TABLE_MAGIC, sizeof(header->magic))) ||
+        (PRIME_TABLE_VERSION != header->version) ||
+        (sizeof(prime_table_header) != header->header_bytes) ||
+        (PRIME_TABLE_BYTE_ORDER != header->byte_order) ||
+        (PRIME_TABLE_BLOCK_BYTES != header->block_bytes)) {
+        return false;
+    }
+
+    if ((header->limit < 2) || (header->limit / 30 + 1 != header->bytes) ||
+        (header->bytes / PRIME_TABLE_BLOCK_BYTES + 1 != header->blocks)) {
+        return false;
+    }
+
+    /* Division avoids overflows for bogus block numbers */
+    const uint64_t payload = size - sizeof(prime_table_header);
+
+    if ((header->bytes > payload) ||
+        ((payload - header->bytes) / sizeof(uint64_t) != header->blocks + 1) ||
+        (0 != (payload - header->bytes) % sizeof(uint64_t))) {
+        return false;
+    }
+
+    const uint64_t *counts = (const uint64_t *)(header + 1);
+
+    return counts[header->blocks] +
+               prime_table_primes_below_7(header->limit) ==
+           header->num_primes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_table_load(const char *path) {
+    if (0 == path) {
+        return false;
+    }
+
+    int fd = open(path, O_RDONLY);
+
+    if (0 > fd) {
+        return false;
+    }
+
+    struct stat status = {0};
+
+    if ((0 != fstat(fd, &status)) || (0 >= status.st_size) ||
+        ((uint64_t)status.st_size > SIZE_MAX)) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = status.st_size;
+    void *memory = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    /* The mapping stays valid without the descriptor */
+    close(fd);
+
+    if (MAP_FAILED == memory) {
+        return false;
+    }
+
+    if (!prime_table_header_valid(memory, size)) {
+        munmap(memory, size);
+        return false;
+    }
+
+    prime_table_free();
+
+    const prime_table_header *header = memory;
+    const uint64_t *counts = (const uint64_t *)(header + 1);
+
+    g_prime_table.limit = header->limit;
+    g_prime_table.bytes = header->bytes;
+    g_prime_table.blocks = header->blocks;
+    g_prime_table.counts = counts;
+    g_prime_table.bits = (const uint8_t *)(counts + header->blocks + 1);
+    g_prime_table.memory = memory;
+    g_prime_table.mapped_bytes = size;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_table_limit() { return g_prime_table.limit; }
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_table_is_prime(uint64_t p) {
+    if (p > g_prime_table.limit) {
+        return false;
+    }
+
+    if (p < 7) {
+        return (2 == p) || (3 == p) || (5 == p);
+    }
+
+    return 0 != (g_prime_table.bits[p / 30] & WHEEL_BIT[p % 30]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns the number of primes <= x, x must be within the table
+ */
+static uint64_t prime_table_count(uint64_t x) {
+    assert(x <= g_prime_table.limit);
+
+    uint64_t count = prime_table_primes_below_7(x);
+
+    if (x < 7) {
+        return count;
+    }
+
+    const uint64_t byte = x / 30;
+    const uint64_t block = byte / PRIME_TABLE_BLOCK_BYTES;
+
+    count += g_prime_table.counts[block];
+
+    for (uint64_t i = block * PRIME_TABLE_BLOCK_BYTES; i < byte; ++i) {
+        count += __builtin_popcount(g_prime_table.bits[i]);
+    }
+
+    uint8_t mask = 0;
+
+    for (size_t j = 0; (j < 8) && (WHEEL_RESIDUES[j] <= x % 30); ++j) {
+        mask |= 1 << j;
+    }
+
+    return count + __builtin_popcount(g_prime_table.bits[byte] & mask);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns the first prime in byte position or later, considering only the
+ * bits set in mask for the first byte.
+ * 0 if there is none within the table.
+ */
+static uint64_t prime_table_scan(uint64_t position, uint8_t mask) {
+    const uint8_t *bits = g_prime_table.bits;
+    uint8_t current = bits[position] & mask;
+
+    while (0 == current) {
+        if (++position >= g_prime_table.bytes) {
+            return 0;
+        }
+
+        current = bits[position];
+    }
+
+    return 30 * position + WHEEL_RESIDUES[__builtin_ctz(current)];
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_table_next(uint64_t n) {
+    if (n >= g_prime_table.limit) {
+        return 0;
+    }
+
+    if (n < 5) {
+        uint64_t p = (n < 2) ? 2 : ((n < 3) ? 3 : 5);
+        return (p <= g_prime_table.limit) ? p : 0;
+    }
+
+    uint64_t start = n + 1;
+    uint64_t residue = start % 30;
+
+    /* All bits for residues >= residue */
+    uint8_t mask = 0xff;
+
+    for (size_t j = 0; (j < 8) && (WHEEL_RESIDUES[j] < residue); ++j) {
+        mask &= ~(1 << j);
+    }
+
+    return prime_table_scan(start / 30, mask);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_table_nth(uint64_t n) {
+    static const uint64_t FIRST_PRIMES[] = {2, 3, 5};
+
+    if (0 == n) {
+        return 0;
+    }
+
+    if (n <= 3) {
+        uint64_t p = FIRST_PRIMES[n - 1];
+        return (p <= g_prime_table.limit) ? p : 0;
+    }
+
+    /* Index among the primes in the bitmap */
+    uint64_t k = n - 3;
+
+    const uint64_t *counts = g_prime_table.counts;
+
+    if ((0 == counts) || (counts[g_prime_table.blocks] < k)) {
+        return 0;
+    }
+
+    /* Last block with less than k primes in front of it */
+    uint64_t lower = 0;
+    uint64_t upper = g_prime_table.blocks;
+
+    while (lower + 1 < upper) {
+        uint64_t middle = lower + (upper - lower) / 2;
+
+        if (counts[middle] < k) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+
+    k -= counts[lower];
+
+    for (uint64_t i = lower * PRIME_TABLE_BLOCK_BYTES; i < g_prime_table.bytes;
+         ++i) {
+        uint8_t current = g_prime_table.bits[i];
+        uint64_t in_byte = __builtin_popcount(current);
+
+        if (k > in_byte) {
+            k -= in_byte;
+            continue;
+        }
+
+        /* Drop the k - 1 lowest bits */
+        while (0 != --k) {
+            current &= current - 1;
+        }
+
+        return 30 * i + WHEEL_RESIDUES[__builtin_ctz(current)];
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_table_foreach(uint64_t lo, uint64_t hi, prime_callback callback,
+                             void *ctx) {
+    uint64_t visited = 0;
+    uint64_t prime = (0 == lo) ? prime_table_next(0) : prime_table_next(lo - 1);
+
+    while ((0 != prime) && (prime < hi)) {
+        ++visited;
+
+        if (!callback(prime, ctx)) {
+            break;
+        }
+
+        prime = prime_table_next(prime);
+    }
+
+    return visited;
+}
+
+/*****************************************************************************
+                                SEGMENTED SIEVE
+ ****************************************************************************/
+
+/*
+ * Sieve of Eratosthenes over arbitrary windows [lo, hi):
+ *
+ * The window is processed in segments of SIEVE_SEGMENT_BITS odd numbers,
+ * small enough for the segment bitmap to stay in the L1 cache.
+ * For every sieving prime p <= sqrt(hi), the index of its next odd multiple
+ * is carried over from one segment to the next.
+ * Thus only the sieving primes and one segment are kept in memory,
+ * regardless of the width of the window.
+ */
+
+/* 32 KiB of odd numbers, i.e. 2^19 numbers per segment */
+#define SIEVE_SEGMENT_BITS (32 * 1024 * 8)
+#define SIEVE_SEGMENT_WORDS (SIEVE_SEGMENT_BITS / 64)
+
+/* Below that, sieving primes are found by a plain sieve */
+#define SIEVE_PLAIN_LIMIT (1 << 16)
+
+typedef struct {
+    uint64_t *primes;
+    size_t count;
+    size_t capacity;
+} prime_buffer;
+
+/*----------------------------------------------------------------------------*/
+
+static bool prime_buffer_append(uint64_t prime, void *ctx) {
+    prime_buffer *buffer = ctx;
+
+    buffer->primes[buffer->count++] = prime;
+
+    return buffer->count < buffer->capacity;
+}
+
+/*----------------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t *primes;
+    size_t count;
+} sieving_primes_buffer;
+
+/*----------------------------------------------------------------------------*/
+
+static bool sieving_primes_append(uint64_t prime, void *ctx) {
+    sieving_primes_buffer *buffer = ctx;
+    buffer->primes[buffer->count++] = (uint32_t)prime;
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Marks all odd multiples of the active sieving primes within one segment.
+ * Segment bit i stands for seg_lo + 2i.
+ * offsets[i] is the bit index of the next odd multiple of primes[i] and is
+ * advanced to the next segment.
+ */
+static void sieve_odd_segment(uint64_t *bits, uint64_t num_bits,
+                              const uint32_t *primes, uint32_t *offsets,
+                              size_t num_active) {
+    for (size_t i = 0; i < num_active; ++i) {
+        const uint64_t p = primes[i];
+        uint64_t j = offsets[i];
+
+        for (; j < num_bits; j += p) {
+            bits[j / 64] |= 1ull << (j % 64);
+        }
+
+        /* j - num_bits < p < 2^32 */
+        offsets[i] = (uint32_t)(j - num_bits);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Bit index of the first odd multiple of p that needs to be crossed off,
+ * relative to the odd number seg_lo.
+ * p * p is the first multiple not crossed off by a smaller prime already.
+ */
+static uint32_t sieve_first_offset(uint64_t p, uint64_t seg_lo) {
+    uint64_t square = p * p;
+
+    if (square >= seg_lo) {
+        return (uint32_t)((square - seg_lo) / 2);
+    }
+
+    /* Distance to the next multiple, which must be odd as well.
+     * Computed as distance since seg_lo + distance might overflow */
+    uint64_t distance = (p - seg_lo % p) % p;
+
+    if (is_odd(distance)) {
+        distance += p;
+    }
+
+    return (uint32_t)(distance / 2);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Marks the bits beyond num_bits in the last word composite
+ */
+static void mark_tail_composite(uint64_t *bits, uint64_t num_bits) {
+    if (0 != num_bits % 64) {
+        bits[num_bits / 64] |= ~0ull << (num_bits % 64);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Passes the numbers first + 2i for all unmarked bits i to callback.
+ * Returns false if callback asked to stop.
+ */
+static bool report_odd_primes(const uint64_t *bits, uint64_t num_words,
+                              uint64_t first, prime_callback callback,
+                              void *ctx, uint64_t *visited) {
+    for (uint64_t w = 0; w < num_words; ++w) {
+        uint64_t candidates = ~bits[w];
+
+        while (0 != candidates) {
+            uint64_t index = 64 * w + __builtin_ctzll(candidates);
+            candidates &= candidates - 1;
+
+            ++*visited;
+
+            if (!callback(first + 2 * index, ctx)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Enumerates all primes in [lo, hi) given all odd primes <= sqrt(hi - 1).
+ * offsets must provide room for num_primes entries.
+ * Sets *stopped if callback asked to stop.
+ */
+static uint64_t sieve_range(uint64_t lo, uint64_t hi, const uint32_t *primes,
+                            size_t num_primes, uint32_t *offsets,
+                            uint64_t *bits, prime_callback callback, void *ctx,
+                            bool *stopped) {
+    uint64_t visited = 0;
+    *stopped = false;
+
+    if ((lo <= 2) && (2 < hi)) {
+        ++visited;
+
+        if (!callback(2, ctx)) {
+            *stopped = true;
+            return visited;
+        }
+    }
+
+    uint64_t seg_lo = (lo < 3) ? 3 : (lo | 1);
+
+    if (seg_lo >= hi) {
+        return visited;
+    }
+
+    /* Number of odd numbers within [seg_lo, hi) */
+    uint64_t remaining = (hi - seg_lo + 1) / 2;
+    size_t num_active = 0;
+
+    while (0 < remaining) {
+        uint64_t num_bits = remaining;
+
+        if (num_bits > SIEVE_SEGMENT_BITS) {
+            num_bits = SIEVE_SEGMENT_BITS;
+        }
+
+        const uint64_t seg_last = seg_lo + 2 * (num_bits - 1);
+
+        while ((num_active < num_primes) &&
+               ((uint64_t)primes[num_active] * primes[num_active] <=
+                seg_last)) {
+            offsets[num_active] = sieve_first_offset(primes[num_active], seg_lo);
+            ++num_active;
+        }
+
+        const uint64_t num_words = (num_bits + 63) / 64;
+        memset(bits, 0, num_words * sizeof(uint64_t));
+
+        sieve_odd_segment(bits, num_bits, primes, offsets, num_active);
+
+        mark_tail_composite(bits, num_bits);
+
+        if (!report_odd_primes(bits, num_words, seg_lo, callback, ctx,
+                               &visited)) {
+            *stopped = true;
+            return visited;
+        }
+
+        remaining -= num_bits;
+
+        if (0 < remaining) {
+            seg_lo += 2 * num_bits;
+        }
+    }
+
+    return visited;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns all odd primes <= max.
+ * max must be < 2^32.
+ */
+static uint32_t *sieving_primes(uint64_t max, size_t *num_primes) {
+    assert(max <= UINT32_MAX);
+
+    *num_primes = 0;
+
+    /* pi(x) < 1.26 x / ln(x) */
+    size_t capacity = 16 + 1.26 * max / log(max + 2);
+    sieving_primes_buffer buffer = {
+        .primes = malloc(capacity * sizeof(uint32_t)),
+        .count = 0,
+    };
+
+    if (0 == buffer.primes) {
+        return 0;
+    }
+
+    if (max <= prime_table_limit()) {
+        prime_table_foreach(3, max + 1, sieving_primes_append, &buffer);
+
+    } else if (max <= SIEVE_PLAIN_LIMIT) {
+        bool composite[SIEVE_PLAIN_LIMIT + 1];
+        memset(composite, 0, (max + 1) * sizeof(bool));
+
+        for (uint64_t i = 3; i <= max; i += 2) {
+            if (composite[i]) continue;
+
+            buffer.primes[buffer.count++] = i;
+
+            for (uint64_t j = i * i; j <= max; j += 2 * i) {
+                composite[j] = true;
+            }
+        }
+
+    } else {
+        size_t num_inner = 0;
+        uint32_t *inner = sieving_primes(isqrt_u64(max), &num_inner);
+        uint32_t *offsets = malloc((num_inner + 1) * sizeof(uint32_t));
+        uint64_t *bits = malloc(SIEVE_SEGMENT_WORDS * sizeof(uint64_t));
+
+        if ((0 == inner) || (0 == offsets) || (0 == bits)) {
+            free(inner);
+            free(offsets);
+            free(bits);
+            free(buffer.primes);
+            return 0;
+        }
+
+        bool stopped = false;
+        sieve_range(3, max + 1, inner, num_inner, offsets, bits,
+                    sieving_primes_append, &buffer, &stopped);
+
+        free(inner);
+        free(offsets);
+        free(bits);
+    }
+
+    assert(buffer.count <= capacity);
+
+    *num_primes = buffer.count;
+    return buffer.primes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Narrow windows high up, e.g. near 2^64, would require far more memory for
+ * the sieving primes than for the window itself.
+ * For those, the entire window is kept in one bitmap instead, and the sieving
+ * primes are streamed from a segmented sieve and crossed off one by one
+ */
+
+/* Upper bound for the bitmap of a narrow window - 128 MiB */
+#define SIEVE_NARROW_WINDOW_BITS (1ull << 30)
+
+typedef struct {
+    uint64_t *bits;
+    uint64_t num_bits;
+    uint64_t first;
+    uint64_t last;
+} narrow_window;
+
+/*----------------------------------------------------------------------------*/
+
+static bool narrow_window_cross_off(uint64_t prime, void *ctx) {
+    narrow_window *window = ctx;
+
+    /* No more sieving primes required */
+    if (prime > window->last / prime) {
+        return false;
+    }
+
+    for (uint64_t j = sieve_first_offset(prime, window->first);
+         j < window->num_bits; j += prime) {
+        window->bits[j / 64] |= 1ull << (j % 64);
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t sieve_narrow_window(uint64_t lo, uint64_t hi,
+                                   prime_callback callback, void *ctx) {
+    assert(2 < lo);
+
+    narrow_window window = {
+        .first = lo | 1,
+        .last = (hi - 1) - is_even(hi - 1),
+    };
+
+    if (window.first > window.last) {
+        return 0;
+    }
+
+    window.num_bits = (window.last - window.first) / 2 + 1;
+
+    uint64_t num_words = (window.num_bits + 63) / 64;
+    window.bits = calloc(num_words, sizeof(uint64_t));
+
+    if (0 == window.bits) {
+        return 0;
+    }
+
+    prime_range_foreach(3, isqrt_u64(window.last) + 1, narrow_window_cross_off,
+                        &window);
+
+    mark_tail_composite(window.bits, window.num_bits);
+
+    uint64_t visited = 0;
+    report_odd_primes(window.bits, num_words, window.first, callback, ctx,
+                      &visited);
+
+    free(window.bits);
+
+    return visited;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool is_narrow_window(uint64_t lo, uint64_t hi) {
+    const uint64_t root = isqrt_u64(hi - 1);
+
+    /* Bytes for the sieving primes and their offsets vs. the window bitmap */
+    const double sieving_bytes = 8 * 1.26 * root / log(root + 2);
+    const uint64_t window_bits = (hi - lo) / 2;
+
+    return (2 < lo) && (window_bits <= SIEVE_NARROW_WINDOW_BITS) &&
+           (window_bits / 8 < sieving_bytes);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_range_foreach(uint64_t lo, uint64_t hi, prime_callback callback,
+                             void *ctx) {
+    if (lo >= hi) {
+        return 0;
+    }
+
+    if (hi - 1 <= prime_table_limit()) {
+        return prime_table_foreach(lo, hi, callback, ctx);
+    }
+
+    const uint64_t root = isqrt_u64(hi - 1);
+
+    if (is_narrow_window(lo, hi)) {
+        return sieve_narrow_window(lo, hi, callback, ctx);
+    }
+
+    size_t num_primes = 0;
+    uint32_t *primes = sieving_primes(root, &num_primes);
+    uint32_t *offsets = malloc((num_primes + 1) * sizeof(uint32_t));
+    uint64_t *bits = malloc(SIEVE_SEGMENT_WORDS * sizeof(uint64_t));
+
+    uint64_t visited = 0;
+
+    if ((0 != primes) && (0 != offsets) && (0 != bits)) {
+        bool stopped = false;
+        visited = sieve_range(lo, hi, primes, num_primes, offsets, bits,
+                              callback, ctx, &stopped);
+    }
+
+    free(primes);
+    free(offsets);
+    free(bits);
+
+    return visited;
+}
+
+/*----------------------------------------------------------------------------*/
+
+size_t prime_range_fill(uint64_t lo, uint64_t hi, uint64_t *buffer,
+                        size_t capacity) {
+    if ((0 == buffer) || (0 == capacity)) {
+        return 0;
+    }
+
+    prime_buffer primes = {
+        .primes = buffer,
+        .count = 0,
+        .capacity = capacity,
+    };
+
+    prime_range_foreach(lo, hi, prime_buffer_append, &primes);
+
+    return primes.count;
+}
+
+/*****************************************************************************
+                                 PRIME ITERATOR
+ ****************************************************************************/
+
+/*
+ * A window of odd numbers around the current position is sieved by the
+ * cached base primes.
+ * The window starts small and doubles up to SIEVE_SEGMENT_BITS whenever it
+ * slides on, thus short walks stay cheap and long ones are amortized.
+ *
+ * Base primes are cached up to PRIME_ITERATOR_BASE_LIMIT only, which bounds
+ * the memory. Beyond the square of that limit, the window serves as a
+ * filter and the remaining candidates are confirmed by is_prime_u64.
+ */
+
+#define PRIME_ITERATOR_MIN_BITS 512
+#define PRIME_ITERATOR_BASE_LIMIT (1 << 20)
+
+/* Largest prime below 2^64 */
+#define LARGEST_PRIME_U64 18446744073709551557ull
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Makes sure the base primes cover max, max <= PRIME_ITERATOR_BASE_LIMIT
+ */
+static bool prime_iterator_base_primes(prime_iterator *it, uint64_t max) {
+    if (max <= it->base_max) {
+        return true;
+    }
+
+    /* Grow geometrically to keep the number of re-sieves low */
+    uint64_t new_max = 2 * it->base_max;
+
+    if (new_max < max) new_max = max;
+    if (new_max > PRIME_ITERATOR_BASE_LIMIT) new_max = PRIME_ITERATOR_BASE_LIMIT;
+
+    size_t num_primes = 0;
+    uint32_t *primes = sieving_primes(new_max, &num_primes);
+
+    if (0 == primes) {
+        return false;
+    }
+
+    free(it->base_primes);
+
+    it->base_primes = primes;
+    it->num_base_primes = num_primes;
+    it->base_max = new_max;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Sieves num_bits odd numbers starting at the odd number lo
+ */
+static bool prime_iterator_sieve(prime_iterator *it, uint64_t lo,
+                                 uint64_t num_bits) {
+    assert(is_odd(lo));
+    assert(0 < num_bits);
+
+    const uint64_t last = lo + 2 * (num_bits - 1);
+    const uint64_t root = isqrt_u64(last);
+
+    uint64_t base_max = root;
+
+    if (base_max > PRIME_ITERATOR_BASE_LIMIT) {
+        base_max = PRIME_ITERATOR_BASE_LIMIT;
+    }
+
+    if (!prime_iterator_base_primes(it, base_max)) {
+        return false;
+    }
+
+    const uint64_t num_words = (num_bits + 63) / 64;
+
+    if (num_words > it->capacity) {
+        uint64_t *bits = realloc(it->bits, num_words * sizeof(uint64_t));
+
+        if (0 == bits) {
+            return false;
+        }
+
+        it->bits = bits;
+        it->capacity = num_words;
+    }
+
+    memset(it->bits, 0, num_words * sizeof(uint64_t));
+
+    for (size_t i = 0; i < it->num_base_primes; ++i) {
+        const uint64_t p = it->base_primes[i];
+
+        if (p > base_max) break;
+
+        for (uint64_t j = sieve_first_offset(p, lo); j < num_bits; j += p) {
+            it->bits[j / 64] |= 1ull << (j % 64);
+        }
+    }
+
+    mark_tail_composite(it->bits, num_bits);
+
+    /* 1 is no prime, but no multiple of anything either */
+    if (1 == lo) {
+        it->bits[0] |= 1;
+    }
+
+    it->lo = lo;
+    it->num_bits = num_bits;
+    it->verify = (root > PRIME_ITERATOR_BASE_LIMIT);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool prime_iterator_is_candidate(const prime_iterator *it,
+                                        uint64_t index) {
+    if (0 != (it->bits[index / 64] & (1ull << (index % 64)))) {
+        return false;
+    }
+
+    return (!it->verify) || is_prime_u64(it->lo + 2 * index);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t prime_iterator_grow(prime_iterator *it) {
+    uint64_t num_bits = it->window_bits;
+
+    if (it->window_bits < SIEVE_SEGMENT_BITS) {
+        it->window_bits *= 2;
+    }
+
+    return num_bits;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void prime_iterator_found(prime_iterator *it, uint64_t prime) {
+    it->next_from = prime + 1;
+    it->prev_from = prime - 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_iterator_init(prime_iterator *it, uint64_t start) {
+    assert(0 != it);
+
+    memset(it, 0, sizeof(*it));
+    prime_iterator_skip_to(it, start);
+
+    /* Base primes are sieved on demand, thus short walks low down are cheap */
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void prime_iterator_skip_to(prime_iterator *it, uint64_t start) {
+    it->next_from = start;
+    it->prev_from = start;
+    it->window_bits = PRIME_ITERATOR_MIN_BITS;
+    it->failed = false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_iterator_next(prime_iterator *it) {
+    it->failed = false;
+
+    if (it->next_from <= 2) {
+        prime_iterator_found(it, 2);
+        return 2;
+    }
+
+    if (it->next_from > LARGEST_PRIME_U64) {
+        return 0;
+    }
+
+    uint64_t candidate = it->next_from | 1;
+
+    for (;;) {
+        const bool within = (0 != it->num_bits) && (it->lo <= candidate) &&
+                            ((candidate - it->lo) / 2 < it->num_bits);
+
+        if (!within) {
+            /* Up to the last odd number, UINT64_MAX */
+            uint64_t num_bits = prime_iterator_grow(it);
+            uint64_t max_bits = (UINT64_MAX - candidate) / 2 + 1;
+
+            if (num_bits > max_bits) num_bits = max_bits;
+
+            if (!prime_iterator_sieve(it, candidate, num_bits)) {
+                it->failed = true;
+                return 0;
+            }
+        }
+
+        for (uint64_t i = (candidate - it->lo) / 2; i < it->num_bits; ++i) {
+            /* Skip whole words of composites */
+            if ((0 == i % 64) && (UINT64_MAX == it->bits[i / 64])) {
+                i += 63;
+                continue;
+            }
+
+            if (prime_iterator_is_candidate(it, i)) {
+                uint64_t prime = it->lo + 2 * i;
+                prime_iterator_found(it, prime);
+                return prime;
+            }
+        }
+
+        /* Not within this window, go on with the next one */
+        candidate = it->lo + 2 * it->num_bits;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_iterator_prev(prime_iterator *it) {
+    it->failed = false;
+
+    if (it->prev_from < 2) {
+        return 0;
+    }
+
+    if (it->prev_from < 3) {
+        prime_iterator_found(it, 2);
+        return 2;
+    }
+
+    uint64_t candidate = it->prev_from - is_even(it->prev_from);
+
+    for (;;) {
+        const bool within = (0 != it->num_bits) && (it->lo <= candidate) &&
+                            ((candidate - it->lo) / 2 < it->num_bits);
+
+        if (!within) {
+            /* Window ending at candidate, starting at 1 at most */
+            uint64_t num_bits = prime_iterator_grow(it);
+            uint64_t max_bits = (candidate - 1) / 2 + 1;
+
+            if (num_bits > max_bits) num_bits = max_bits;
+
+            if (!prime_iterator_sieve(it, candidate - 2 * (num_bits - 1),
+                                      num_bits)) {
+                it->failed = true;
+                return 0;
+            }
+        }
+
+        for (uint64_t i = (candidate - it->lo) / 2 + 1; 0 < i; --i) {
+            if (prime_iterator_is_candidate(it, i - 1)) {
+                uint64_t prime = it->lo + 2 * (i - 1);
+                prime_iterator_found(it, prime);
+                return prime;
+            }
+        }
+
+        if (1 == it->lo) {
+            /* No odd prime left below */
+            prime_iterator_found(it, 2);
+            return 2;
+        }
+
+        candidate = it->lo - 2;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_iterator_failed(const prime_iterator *it) {
+    assert(0 != it);
+
+    return it->failed;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void prime_iterator_free(prime_iterator *it) {
+    if (0 == it) return;
+
+    free(it->bits);
+    free(it->base_primes);
+
+    memset(it, 0, sizeof(*it));
+}
+
+/*****************************************************************************
+                                 PRIME COUNTING
+ ****************************************************************************/
+
+/*
+ * Lucy_Hedgehog's method:
+ *
+ * Let S(v, p) be the number of odd 3 <= n <= v that are prime or have no
+ * prime factor <= p. Then S(v, p) = S(v, p - 1) for composite p, and for
+ * prime p the odd multiples p * m with m free of factors < p drop out:
+ *
+ *   S(v, p) = S(v, p - 1) - (S(v / p, p - 1) - S(p - 1, p - 1))
+ *
+ * Only the values v = x / i and v <= sqrt(x) ever show up, 2 sqrt(x) in
+ * total, hence the whole thing takes O(x^(3/4)) time and O(sqrt(x)) memory.
+ * Since p is odd, S(x / i) is required for odd i only.
+ */
+
+/* nth_prime walks the primes once it is that close */
+#define NTH_PRIME_WALK 20000
+
+/* pi(2^64) */
+#define PRIME_COUNT_U64 425656284035217743ull
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t lucy_hedgehog(uint64_t x) {
+    assert(2 <= x);
+
+    const uint64_t root = isqrt_u64(x);
+
+    if (root >= SIZE_MAX / 8) {
+        return 0;
+    }
+
+    /* small[v] = S(v), large[i / 2] = S(x / i) for odd i */
+    uint32_t *small = malloc((root + 1) * sizeof(uint32_t));
+    uint64_t *large = malloc((root / 2 + 1) * sizeof(uint64_t));
+
+    if ((0 == small) || (0 == large)) {
+        free(small);
+        free(large);
+        return 0;
+    }
+
+    small[0] = 0;
+
+    for (uint64_t v = 1; v <= root; ++v) {
+        small[v] = (v - 1) / 2;
+    }
+
+    for (uint64_t i = 1; i <= root; i += 2) {
+        large[i / 2] = (x / i - 1) / 2;
+    }
+
+    for (uint64_t p = 3; p <= root; p += 2) {
+        if (small[p] == small[p - 1]) continue;
+
+        const uint64_t below = small[p - 1];
+        const uint64_t square = p * p;
+
+        uint64_t last = x / square;
+
+        if (last > root) last = root;
+
+        for (uint64_t i = 1; i <= last; i += 2) {
+            const uint64_t d = i * p;
+            const uint64_t s = (d <= root) ? large[d / 2] : small[x / d];
+
+            large[i / 2] -= s - below;
+        }
+
+        for (uint64_t v = root; v >= square; --v) {
+            small[v] -= small[v / p] - below;
+        }
+    }
+
+    /* Plus 2 */
+    uint64_t count = large[0] + 1;
+
+    free(small);
+    free(large);
+
+    return count;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_count(uint64_t x) {
+    if (x <= prime_table_limit()) {
+        return prime_table_count(x);
+    }
+
+    if (x < 2) {
+        return 0;
+    }
+
+    return lucy_hedgehog(x);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Returns an approximation of the n-th prime, n >= 6
+ */
+static double nth_prime_estimate(uint64_t n) {
+    const double ln = log(n);
+    const double lnln = log(ln);
+
+    return n * (ln + lnln - 1 + (lnln - 2) / ln);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t nth_prime(uint64_t n) {
+    static const uint64_t FIRST_PRIMES[] = {2, 3, 5, 7, 11};
+
+    if ((0 == n) || (n > PRIME_COUNT_U64)) {
+        return 0;
+    }
+
+    if (n <= 5) {
+        return FIRST_PRIMES[n - 1];
+    }
+
+    if (0 != prime_table_nth(n)) {
+        return prime_table_nth(n);
+    }
+
+    /* Newton steps with the density of the primes near x, 1 / ln(x) */
+    double estimate = nth_prime_estimate(n);
+    uint64_t x = (estimate < (double)UINT64_MAX) ? estimate : UINT64_MAX;
+    uint64_t count = 0;
+
+    for (;;) {
+        count = prime_count(x);
+
+        if (0 == count) {
+            return 0;
+        }
+
+        const double missing = (double)n - (double)count;
+
+        if (fabs(missing) <= NTH_PRIME_WALK) {
+            break;
+        }
+
+        estimate = x + missing * log(x);
+
+        if (estimate < 2) estimate = 2;
+
+        x = (estimate < (double)UINT64_MAX) ? estimate : UINT64_MAX;
+    }
+
+    /* count primes <= x: walk down from x, or up from x + 1 */
+    prime_iterator primes = {0};
+
+    if (!prime_iterator_init(&primes, x)) {
+        return 0;
+    }
+
+    uint64_t prime = 0;
+
+    /* A step running out of memory leaves prime 0 */
+    if (count >= n) {
+        for (uint64_t i = count;
+             (i >= n) && (!prime_iterator_failed(&primes)); --i) {
+            prime = prime_iterator_prev(&primes);
+        }
+    } else {
+        prime_iterator_skip_to(&primes, x + 1);
+
+        for (uint64_t i = count;
+             (i < n) && (!prime_iterator_failed(&primes)); ++i) {
+            prime = prime_iterator_next(&primes);
+        }
+    }
+
+    prime_iterator_free(&primes);
+
+    return prime;
+}
+
+/*****************************************************************************
+                              ARITHMETIC FUNCTIONS
+ ****************************************************************************/
+
+/* Numbers per segment of arithmetic_functions_range, at least */
+#define ARITHMETIC_FUNCTIONS_SEGMENT (1ull << 16)
+
+/* sigma(n) < 8 n for all n < 2^64 by Robin's bound, thus fits below */
+#define ARITHMETIC_FUNCTIONS_SIGMA_LIMIT (1ull << 61)
+
+/* Windows narrower than sqrt(hi) / ARITHMETIC_FUNCTIONS_NARROW are factorized
+ * number by number - cheaper than going through all primes up to sqrt(hi),
+ * e.g. 200 million for windows near 2^64 */
+#define ARITHMETIC_FUNCTIONS_NARROW 16384
+
+/*----------------------------------------------------------------------------*/
+
+static void arithmetic_functions_set(const arithmetic_functions *f, size_t i,
+                                     uint64_t phi, int8_t mu, uint32_t tau,
+                                     uint64_t sigma, uint8_t omega) {
+    if (0 != f->phi) f->phi[i] = phi;
+    if (0 != f->mu) f->mu[i] = mu;
+    if (0 != f->tau) f->tau[i] = tau;
+    if (0 != f->sigma) f->sigma[i] = sigma;
+    if (0 != f->omega) f->omega[i] = omega;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool arithmetic_functions_sieve(uint64_t limit,
+                                const arithmetic_functions *f) {
+    assert(0 != f);
+
+    if (limit > (1ull << 32)) {
+        return false;
+    }
+
+    if (0 < limit) arithmetic_functions_set(f, 0, 0, 0, 0, 0, 0);
+    if (1 < limit) arithmetic_functions_set(f, 1, 1, 1, 1, 1, 0);
+
+    if (limit <= 2) {
+        return true;
+    }
+
+    /* tau and sigma of n * p, p being the smallest prime factor of n, are
+     * derived from n with the powers of p removed */
+    const bool need_rest = (0 != f->tau) || (0 != f->sigma);
+
+    /* Smallest prime factor, 0 if not reached yet, i.e. prime */
+    uint32_t *lpf = calloc(limit, sizeof(uint32_t));
+    uint32_t *rest = need_rest ? malloc(limit * sizeof(uint32_t)) : 0;
+
+    /* pi(x) < 1.26 x / ln(x) */
+    size_t capacity = 16 + 1.26 * limit / log(limit);
+    uint32_t *primes = malloc(capacity * sizeof(uint32_t));
+
+    if ((0 == lpf) || (need_rest && (0 == rest)) || (0 == primes)) {
+        free(lpf);
+        free(rest);
+        free(primes);
+        return false;
+    }
+
+    uint64_t *phi = f->phi;
+    int8_t *mu = f->mu;
+    uint32_t *tau = f->tau;
+    uint64_t *sigma = f->sigma;
+    uint8_t *omega = f->omega;
+
+    size_t num_primes = 0;
+
+    if (need_rest) rest[1] = 1;
+
+    for (uint64_t i = 2; i < limit; ++i) {
+        if (0 == lpf[i]) {
+            lpf[i] = i;
+            primes[num_primes++] = i;
+
+            if (need_rest) rest[i] = 1;
+
+            arithmetic_functions_set(f, i, i - 1, -1, 2, i + 1, 1);
+        }
+
+        /* All primes up to the smallest prime factor of i */
+        for (size_t k = 0; k < num_primes; ++k) {
+            const uint64_t p = primes[k];
+            const uint64_t m = i * p;
+
+            if (m >= limit) break;
+
+            lpf[m] = p;
+
+            if (p == lpf[i]) {
+                /* n = p^e * r:
+                 * tau(n p) = (e + 2) tau(r) = tau(n) + tau(r)
+                 * sigma(n p) = (1 + p sigma(p^e)) sigma(r)
+                 *            = sigma(r) + p sigma(n) */
+                const uint32_t r = need_rest ? rest[i] : 0;
+
+                if (need_rest) rest[m] = r;
+                if (0 != phi) phi[m] = phi[i] * p;
+                if (0 != mu) mu[m] = 0;
+                if (0 != tau) tau[m] = tau[i] + tau[r];
+                if (0 != sigma) sigma[m] = sigma[r] + p * sigma[i];
+                if (0 != omega) omega[m] = omega[i];
+
+                break;
+            }
+
+            /* p does not divide i, all of the functions are multiplicative */
+            if (need_rest) rest[m] = i;
+            if (0 != phi) phi[m] = phi[i] * (p - 1);
+            if (0 != mu) mu[m] = -mu[i];
+            if (0 != tau) tau[m] = 2 * tau[i];
+            if (0 != sigma) sigma[m] = sigma[i] * (p + 1);
+            if (0 != omega) omega[m] = omega[i] + 1;
+        }
+    }
+
+    free(lpf);
+    free(rest);
+    free(primes);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Accounts for p^e exactly dividing the number at entry i
+ */
+static void arithmetic_functions_apply(const arithmetic_functions *f,
+                                       size_t i, uint64_t p, uint32_t e) {
+    uint64_t power = 1;
+    uint64_t divisor_sum = 1;
+
+    for (uint32_t k = 0; k < e; ++k) {
+        power *= p;
+        divisor_sum = divisor_sum * p + 1;
+    }
+
+    if (0 != f->phi) f->phi[i] *= power / p * (p - 1);
+    if (0 != f->mu) f->mu[i] = (1 < e) ? 0 : -f->mu[i];
+    if (0 != f->tau) f->tau[i] *= e + 1;
+    if (0 != f->sigma) f->sigma[i] *= divisor_sum;
+    if (0 != f->omega) f->omega[i] += 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Fills entries out ... out + width - 1 for lo <= n < lo + width.
+ * primes are the odd primes up to at least sqrt(lo + width - 1), rem holds
+ * width numbers.
+ */
+static void arithmetic_functions_segment(uint64_t lo, uint64_t width,
+                                         size_t out, const uint32_t *primes,
+                                         size_t num_primes, uint64_t *rem,
+                                         const arithmetic_functions *f) {
+    for (uint64_t i = 0; i < width; ++i) {
+        rem[i] = lo + i;
+        arithmetic_functions_set(f, out + i, 1, 1, 1, 1, 0);
+    }
+
+    if (0 == lo) {
+        /* Nothing to divide out of 0 */
+        rem[0] = 1;
+        arithmetic_functions_set(f, out, 0, 0, 0, 0, 0);
+    }
+
+    for (uint64_t i = is_even(lo) ? 0 : 1; i < width; i += 2) {
+        if (1 == rem[i]) continue;
+
+        const uint32_t e = __builtin_ctzll(rem[i]);
+        rem[i] >>= e;
+        arithmetic_functions_apply(f, out + i, 2, e);
+    }
+
+    const uint64_t last = lo + width - 1;
+
+    for (size_t k = 0; k < num_primes; ++k) {
+        const uint64_t p = primes[k];
+
+        if (p * p > last) break;
+
+        uint64_t first = (p - lo % p) % p;
+
+        if (0 == lo) first = p;
+
+        for (uint64_t i = first; i < width; i += p) {
+            uint64_t r = rem[i] / p;
+            uint32_t e = 1;
+
+            while (0 == r % p) {
+                r /= p;
+                ++e;
+            }
+
+            rem[i] = r;
+            arithmetic_functions_apply(f, out + i, p, e);
+        }
+    }
+
+    /* At most one prime factor beyond sqrt(last) remains */
+    for (uint64_t i = 0; i < width; ++i) {
+        if (1 < rem[i]) {
+            arithmetic_functions_apply(f, out + i, rem[i], 1);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void arithmetic_functions_factorize(uint64_t lo, uint64_t hi,
+                                           const arithmetic_functions *f) {
+    uint64_t factors[FACTORIZE_MAX_FACTORS] = {0};
+    uint32_t exponents[FACTORIZE_MAX_FACTORS] = {0};
+
+    for (uint64_t n = lo; n < hi; ++n) {
+        if (0 == n) {
+            arithmetic_functions_set(f, 0, 0, 0, 0, 0, 0);
+            continue;
+        }
+
+        arithmetic_functions_set(f, n - lo, 1, 1, 1, 1, 0);
+
+        const size_t num_factors = factorize_u64(n, factors, exponents);
+
+        for (size_t k = 0; k < num_factors; ++k) {
+            arithmetic_functions_apply(f, n - lo, factors[k], exponents[k]);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool arithmetic_functions_range(uint64_t lo, uint64_t hi,
+                                const arithmetic_functions *f) {
+    assert(0 != f);
+
+    if (hi <= lo) {
+        return true;
+    }
+
+    if ((0 != f->sigma) && (hi > ARITHMETIC_FUNCTIONS_SIGMA_LIMIT)) {
+        return false;
+    }
+
+    const uint64_t max = isqrt_u64(hi - 1);
+
+    if (hi - lo < max / ARITHMETIC_FUNCTIONS_NARROW) {
+        arithmetic_functions_factorize(lo, hi, f);
+        return true;
+    }
+
+    /* Segments at least as wide as there are sieving primes, thus finding
+     * the first multiples costs at most one division per number */
+    uint64_t segment = (max > ARITHMETIC_FUNCTIONS_SEGMENT)
+                           ? max
+                           : ARITHMETIC_FUNCTIONS_SEGMENT;
+
+    if (segment > hi - lo) segment = hi - lo;
+
+    size_t num_primes = 0;
+    uint32_t *primes = sieving_primes(max, &num_primes);
+    uint64_t *rem = malloc(segment * sizeof(uint64_t));
+
+    if ((0 == primes) || (0 == rem)) {
+        free(primes);
+        free(rem);
+        return false;
+    }
+
+    for (uint64_t done = 0; done < hi - lo; done += segment) {
+        const uint64_t width =
+            (hi - lo - done < segment) ? hi - lo - done : segment;
+
+        arithmetic_functions_segment(lo + done, width, done, primes,
+                                     num_primes, rem, f);
+    }
+
+    free(primes);
+    free(rem);
+
+    return true;
+}
+
+/*****************************************************************************
+                            PARALLEL SEGMENTED SIEVE
+ ****************************************************************************/
+
+/*
+ * The window is split into chunks of several segments each.
+ * Worker threads claim chunks one after the other and sieve them against
+ * the shared sieving primes, each thread using its own segment bitmap and
+ * offsets.
+ *
+ * For ordered output, the primes of each chunk are buffered, and the calling
+ * thread passes them on to the callback chunk by chunk, in order.
+ * Workers never run more than PARALLEL_SIEVE_CHUNKS_PER_THREAD chunks per
+ * thread ahead of the caller, which bounds the memory.
+ */
+
+/* Minimum chunk width in segments */
+#define PARALLEL_SIEVE_CHUNK_SEGMENTS 16
+
+#define PARALLEL_SIEVE_CHUNKS_PER_THREAD 2
+
+#ifdef NUMERICS_FAULT_INJECTION
+
+/* Chunk of the ordered mode to fail as if out of memory, for testing */
+static uint64_t g_fault_chunk = UINT64_MAX;
+
+void numerics_fault_parallel_sieve(uint64_t chunk) { g_fault_chunk = chunk; }
+
+#endif
+
+typedef struct {
+    uint64_t *primes;
+    size_t count;
+    size_t capacity;
+    bool done;
+    bool failed;
+} parallel_sieve_slot;
+
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t chunk_width;
+    uint64_t num_chunks;
+
+    const uint32_t *primes;
+    size_t num_primes;
+
+    /* Ordered mode: ring of buffers, chunk c goes to slot c % num_slots */
+    bool ordered;
+    parallel_sieve_slot *slots;
+    size_t num_slots;
+
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+
+    uint64_t next_chunk;
+    uint64_t next_to_report;
+    bool stop;
+
+    /* Totals mode: accumulated under lock */
+    uint64_t count;
+    unsigned __int128 sum;
+    bool failed;
+
+} parallel_sieve;
+
+typedef struct {
+    uint64_t count;
+    unsigned __int128 sum;
+} parallel_sieve_totals;
+
+/*----------------------------------------------------------------------------*/
+
+static bool parallel_sieve_add(uint64_t prime, void *ctx) {
+    parallel_sieve_totals *totals = ctx;
+
+    ++totals->count;
+    totals->sum += prime;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool parallel_sieve_buffer(uint64_t prime, void *ctx) {
+    parallel_sieve_slot *slot = ctx;
+
+    if (slot->count == slot->capacity) {
+        size_t capacity = 2 * slot->capacity + 1024;
+        uint64_t *primes = realloc(slot->primes, capacity * sizeof(uint64_t));
+
+        if (0 == primes) {
+            slot->failed = true;
+            return false;
+        }
+
+        slot->primes = primes;
+        slot->capacity = capacity;
+    }
+
+    slot->primes[slot->count++] = prime;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Claims the next chunk, waiting until the caller caught up in ordered mode.
+ * Returns false if there is nothing left to do.
+ */
+static bool parallel_sieve_claim(parallel_sieve *sieve, uint64_t *chunk) {
+    bool claimed = false;
+
+    pthread_mutex_lock(&sieve->lock);
+
+    while ((!sieve->stop) && (sieve->next_chunk < sieve->num_chunks) &&
+           sieve->ordered &&
+           (sieve->next_chunk >= sieve->next_to_report + sieve->num_slots)) {
+        pthread_cond_wait(&sieve->changed, &sieve->lock);
+    }
+
+    if ((!sieve->stop) && (sieve->next_chunk < sieve->num_chunks)) {
+        *chunk = sieve->next_chunk++;
+        claimed = true;
+    }
+
+    pthread_mutex_unlock(&sieve->lock);
+
+    return claimed;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void *parallel_sieve_worker(void *arg) {
+    parallel_sieve *sieve = arg;
+
+    uint32_t *offsets = malloc((sieve->num_primes + 1) * sizeof(uint32_t));
+    uint64_t *bits = malloc(SIEVE_SEGMENT_WORDS * sizeof(uint64_t));
+
+    parallel_sieve_totals totals = {0};
+    bool failed = (0 == offsets) || (0 == bits);
+    uint64_t chunk = 0;
+
+    while ((!failed) && parallel_sieve_claim(sieve, &chunk)) {
+        uint64_t chunk_lo = sieve->lo + chunk * sieve->chunk_width;
+        uint64_t chunk_hi = sieve->hi;
+
+        if (sieve->hi - chunk_lo > sieve->chunk_width) {
+            chunk_hi = chunk_lo + sieve->chunk_width;
+        }
+
+        bool stopped = false;
+
+        if (!sieve->ordered) {
+            sieve_range(chunk_lo, chunk_hi, sieve->primes, sieve->num_primes,
+                        offsets, bits, parallel_sieve_add, &totals, &stopped);
+            continue;
+        }
+
+        /* The slot is ours until the caller reported it */
+        parallel_sieve_slot *slot = sieve->slots + chunk % sieve->num_slots;
+
+#ifdef NUMERICS_FAULT_INJECTION
+        if (chunk == g_fault_chunk) {
+            slot->failed = true;
+        }
+#endif
+
+        if (!slot->failed) {
+            sieve_range(chunk_lo, chunk_hi, sieve->primes, sieve->num_primes,
+                        offsets, bits, parallel_sieve_buffer, slot, &stopped);
+        }
+
+        pthread_mutex_lock(&sieve->lock);
+        slot->done = true;
+        pthread_cond_broadcast(&sieve->changed);
+        pthread_mutex_unlock(&sieve->lock);
+    }
+
+    free(offsets);
+    free(bits);
+
+    pthread_mutex_lock(&sieve->lock);
+
+    sieve->count += totals.count;
+    sieve->sum += totals.sum;
+
+    if (failed) {
+        /* Let the caller notice instead of waiting forever */
+        sieve->failed = true;
+        sieve->stop = true;
+        pthread_cond_broadcast(&sieve->changed);
+    }
+
+    pthread_mutex_unlock(&sieve->lock);
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Passes the buffered chunks to callback in order.
+ * Runs in the calling thread while the workers sieve.
+ * Returns false if a chunk failed before callback asked to stop, *last is
+ * the last prime reported then.
+ */
+static bool parallel_sieve_report(parallel_sieve *sieve,
+                                  prime_callback callback, void *ctx,
+                                  uint64_t *visited, uint64_t *last) {
+    bool complete = true;
+
+    for (uint64_t chunk = 0; chunk < sieve->num_chunks; ++chunk) {
+        parallel_sieve_slot *slot = sieve->slots + chunk % sieve->num_slots;
+
+        pthread_mutex_lock(&sieve->lock);
+
+        /* After a failure nothing gets claimed anymore, but a claimed chunk
+         * is still being sieved into the slot */
+        while ((!slot->done) &&
+               ((!sieve->failed) || (chunk < sieve->next_chunk))) {
+            pthread_cond_wait(&sieve->changed, &sieve->lock);
+        }
+
+        bool ok = slot->done && (!slot->failed);
+
+        if (slot->failed) {
+            sieve->failed = true;
+        }
+
+        pthread_mutex_unlock(&sieve->lock);
+
+        bool go_on = ok;
+
+        for (size_t i = 0; go_on && (i < slot->count); ++i) {
+            ++*visited;
+            *last = slot->primes[i];
+            go_on = callback(*last, ctx);
+        }
+
+        complete = ok;
+
+        pthread_mutex_lock(&sieve->lock);
+
+        slot->done = false;
+        slot->count = 0;
+        ++sieve->next_to_report;
+
+        if (!go_on) {
+            sieve->stop = true;
+        }
+
+        pthread_cond_broadcast(&sieve->changed);
+        pthread_mutex_unlock(&sieve->lock);
+
+        if (!go_on) break;
+    }
+
+    return complete;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static size_t available_threads(size_t num_threads) {
+    if (0 != num_threads) {
+        return num_threads;
+    }
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (online > 0) ? (size_t)online : 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Sieves [lo, hi) with num_threads workers.
+ * Ordered mode if callback is given, totals are accumulated otherwise.
+ * Returns false if sieving could not be done in parallel, in ordered mode
+ * *count primes up to *last have been reported then.
+ */
+static bool run_parallel_sieve(uint64_t lo, uint64_t hi, size_t num_threads,
+                               prime_callback callback, void *ctx,
+                               uint64_t *count, uint64_t *last,
+                               unsigned __int128 *sum) {
+    num_threads = available_threads(num_threads);
+
+    const uint64_t root = isqrt_u64(hi - 1);
+
+    parallel_sieve sieve = {
+        .lo = lo,
+        .hi = hi,
+        .ordered = (0 != callback),
+    };
+
+    uint32_t *primes = sieving_primes(root, &sieve.num_primes);
+
+    if (0 == primes) {
+        return false;
+    }
+
+    sieve.primes = primes;
+
+    /* Finding the first multiple of every sieving prime costs a division
+     * per chunk - keep chunks wide enough for that not to matter */
+    uint64_t chunk_segments = PARALLEL_SIEVE_CHUNK_SEGMENTS;
+
+    if (chunk_segments < sieve.num_primes / SIEVE_SEGMENT_BITS) {
+        chunk_segments = sieve.num_primes / SIEVE_SEGMENT_BITS;
+    }
+
+    sieve.chunk_width = 2 * SIEVE_SEGMENT_BITS * chunk_segments;
+    sieve.num_chunks = (hi - lo) / sieve.chunk_width +
+                       ((0 == (hi - lo) % sieve.chunk_width) ? 0 : 1);
+
+    if (num_threads > sieve.num_chunks) {
+        num_threads = sieve.num_chunks;
+    }
+
+    sieve.num_slots = PARALLEL_SIEVE_CHUNKS_PER_THREAD * num_threads;
+
+    pthread_t *threads = calloc(num_threads, sizeof(pthread_t));
+    sieve.slots = calloc(sieve.num_slots, sizeof(parallel_sieve_slot));
+
+    if ((0 == threads) || (0 == sieve.slots)) {
+        free(threads);
+        free(sieve.slots);
+        free(primes);
+        return false;
+    }
+
+    pthread_mutex_init(&sieve.lock, 0);
+    pthread_cond_init(&sieve.changed, 0);
+
+    size_t started = 0;
+
+    for (; started < num_threads; ++started) {
+        if (0 != pthread_create(threads + started, 0, parallel_sieve_worker,
+                                &sieve)) {
+            break;
+        }
+    }
+
+    bool complete = (0 != started);
+
+    if (complete && sieve.ordered) {
+        complete = parallel_sieve_report(&sieve, callback, ctx, count, last);
+    }
+
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(threads[i], 0);
+    }
+
+    if (!sieve.ordered) {
+        *count = sieve.count;
+        *sum = sieve.sum;
+    }
+
+    pthread_cond_destroy(&sieve.changed);
+    pthread_mutex_destroy(&sieve.lock);
+
+    for (size_t i = 0; i < sieve.num_slots; ++i) {
+        free(sieve.slots[i].primes);
+    }
+
+    free(sieve.slots);
+    free(threads);
+    free(primes);
+
+    /* Once everything got reported, a late failure does not matter */
+    return complete && (sieve.ordered || (!sieve.failed));
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Whether it is worth to spread [lo, hi) over several threads
+ */
+static bool sieve_in_parallel(uint64_t lo, uint64_t hi, size_t num_threads) {
+    if ((lo >= hi) || (1 == available_threads(num_threads))) {
+        return false;
+    }
+
+    if ((hi - 1 <= prime_table_limit()) || is_narrow_window(lo, hi)) {
+        return false;
+    }
+
+    return (hi - lo) / 2 >
+           PARALLEL_SIEVE_CHUNK_SEGMENTS * (uint64_t)SIEVE_SEGMENT_BITS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t prime_range_foreach_parallel(uint64_t lo, uint64_t hi,
+                                      size_t num_threads,
+                                      prime_callback callback, void *ctx) {
+    uint64_t visited = 0;
+    uint64_t last = 0;
+    unsigned __int128 sum = 0;
+
+    if (sieve_in_parallel(lo, hi, num_threads) &&
+        run_parallel_sieve(lo, hi, num_threads, callback, ctx, &visited,
+                           &last, &sum)) {
+        return visited;
+    }
+
+    /* Either not worth it, or the parallel run failed - carry on behind the
+     * last prime it reported */
+    const uint64_t from = (0 == visited) ? lo : last + 1;
+
+    return visited + prime_range_foreach(from, hi, callback, ctx);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool prime_range_totals_parallel(uint64_t lo, uint64_t hi, size_t num_threads,
+                                 prime_range_totals *totals) {
+    if (0 == totals) {
+        return false;
+    }
+
+    uint64_t count = 0;
+    uint64_t last = 0;
+    unsigned __int128 sum = 0;
+
+    if ((!sieve_in_parallel(lo, hi, num_threads)) ||
+        (!run_parallel_sieve(lo, hi, num_threads, 0, 0, &count, &last,
+                             &sum))) {
+        parallel_sieve_totals sequential = {0};
+        prime_range_foreach(lo, hi, parallel_sieve_add, &sequential);
+
+        count = sequential.count;
+        sum = sequential.sum;
+    }
+
+    totals->count = count;
+    totals->sum_low = (uint64_t)sum;
+    totals->sum_high = (uint64_t)(sum >> 64);
+
+    return true;
+}
+
+/*****************************************************************************
+                                     ARRAYS
+ ****************************************************************************/
+
+/*
+ * Element wise kernels over contiguous buffers.
+ *
+ * On x86-64, AVX2 and AVX-512 variants are compiled alongside the scalar
+ * code by means of target attributes and picked once at runtime, depending
+ * on what the CPU supports.
+ * The environment variable NUMERICS_SIMD (none, avx2, avx512) lowers the
+ * choice, e.g. for testing the fallbacks.
+ */
+
+typedef enum { SIMD_NONE = 0, SIMD_AVX2, SIMD_AVX512 } simd_level;
+
+/* Trial division of the array kernels covers all odd primes below this */
+#define ARRAY_TRIAL_PRIMES_LIMIT 256
+
+/* Odd primes below ARRAY_TRIAL_PRIMES_LIMIT */
+#define ARRAY_TRIAL_PRIMES_COUNT 53
+
+/* Lanes of the interleaved Miller-Rabin test */
+#define ARRAY_RABIN_MILLER_LANES 4
+
+static pthread_once_t g_array_once = PTHREAD_ONCE_INIT;
+
+static struct {
+    simd_level simd;
+
+    /* x is divisible by odd p iff x * p^-1 mod 2^64 <= (2^64 - 1) / p -
+     * see Granlund, Montgomery: Division by invariant integers using
+     * multiplication */
+    uint64_t primes[ARRAY_TRIAL_PRIMES_COUNT];
+    uint64_t inverses[ARRAY_TRIAL_PRIMES_COUNT];
+    uint64_t limits[ARRAY_TRIAL_PRIMES_COUNT];
+
+} g_array;
+
+/*----------------------------------------------------------------------------*/
+
+static simd_level detect_simd_level() {
+    simd_level level = SIMD_NONE;
+
+#ifdef NUMERICS_X86_SIMD
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        level = SIMD_AVX2;
+    }
+
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512cd")) {
+        level = SIMD_AVX512;
+    }
+
+#endif
+
+    const char *requested = getenv("NUMERICS_SIMD");
+
+    if (0 == requested) {
+        return level;
+    }
+
+    if (0 == strcmp(requested, "none")) {
+        return SIMD_NONE;
+    }
+
+    if ((0 == strcmp(requested, "avx2")) && (SIMD_AVX2 < level)) {
+        return SIMD_AVX2;
+    }
+
+    return level;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void array_init() {
+    g_array.simd = detect_simd_level();
+
+    size_t count = 0;
+
+    for (uint64_t p = 3; p < ARRAY_TRIAL_PRIMES_LIMIT; p += 2) {
+        if (!is_prime_u64(p)) continue;
+
+        /* Newton: every step doubles the number of correct low bits */
+        uint64_t inverse = p;
+
+        for (size_t i = 0; i < 5; ++i) {
+            inverse *= 2 - p * inverse;
+        }
+
+        g_array.primes[count] = p;
+        g_array.inverses[count] = inverse;
+        g_array.limits[count] = UINT64_MAX / p;
+        ++count;
+    }
+
+    assert(ARRAY_TRIAL_PRIMES_COUNT == count);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * The widest instruction set the kernels may use
+ */
+static simd_level array_simd_level() {
+    pthread_once(&g_array_once, array_init);
+    return g_array.simd;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Sets composite[i] if values[i] has an odd prime factor below
+ * ARRAY_TRIAL_PRIMES_LIMIT other than itself
+ */
+static void trial_divide_scalar(const uint64_t *values, bool *composite,
+                                size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t x = values[i];
+        bool divisible = false;
+
+        for (size_t k = 0; k < ARRAY_TRIAL_PRIMES_COUNT; ++k) {
+            divisible |= (x * g_array.inverses[k] <= g_array.limits[k]) &&
+                         (x != g_array.primes[k]);
+        }
+
+        composite[i] = divisible;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void gcd_scalar(const uint64_t *a, const uint64_t *b, uint64_t *gcds,
+                       size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        gcds[i] = gcd_u64(a[i], b[i]);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+#ifdef NUMERICS_X86_SIMD
+
+/**
+ * Low 64 bits of the lane wise products - AVX2 lacks a 64 bit multiply,
+ * assemble it from 32 x 32 bit ones
+ */
+__attribute__((target("avx2"))) static __m256i mullo_avx2(__m256i a,
+                                                          __m256i b) {
+    __m256i a_high = _mm256_srli_epi64(a, 32);
+    __m256i b_high = _mm256_srli_epi64(b, 32);
+
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a_high, b),
+                                     _mm256_mul_epu32(a, b_high));
+
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b),
+                            _mm256_slli_epi64(cross, 32));
+}
+
+/*----------------------------------------------------------------------------*/
+
+__attribute__((target("avx2"))) static void
+trial_divide_avx2(const uint64_t *values, bool *composite, size_t count) {
+    /* AVX2 compares signed only - flip the sign bits for unsigned order */
+    const __m256i sign = _mm256_set1_epi64x((int64_t)(1ull << 63));
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i *)(values + i));
+        __m256i divisible = _mm256_setzero_si256();
+
+        for (size_t k = 0; k < ARRAY_TRIAL_PRIMES_COUNT; ++k) {
+            __m256i product =
+                mullo_avx2(x, _mm256_set1_epi64x(g_array.inverses[k]));
+
+            __m256i above = _mm256_cmpgt_epi64(
+                _mm256_xor_si256(product, sign),
+                _mm256_set1_epi64x(g_array.limits[k] ^ (1ull << 63)));
+
+            __m256i is_p = _mm256_cmpeq_epi64(
+                x, _mm256_set1_epi64x(g_array.primes[k]));
+
+            /* divisible |= !above & !is_p */
+            divisible = _mm256_or_si256(
+                divisible, _mm256_andnot_si256(_mm256_or_si256(above, is_p),
+                                               _mm256_set1_epi64x(-1)));
+        }
+
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(divisible));
+
+        for (size_t lane = 0; lane < 4; ++lane) {
+            composite[i + lane] = 0 != (mask & (1 << lane));
+        }
+    }
+
+    trial_divide_scalar(values + i, composite + i, count - i);
+}
+
+/*----------------------------------------------------------------------------*/
+
+__attribute__((target("avx512f,avx512dq"))) static void
+trial_divide_avx512(const uint64_t *values, bool *composite, size_t count) {
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m512i x = _mm512_loadu_si512(values + i);
+        __mmask8 divisible = 0;
+
+        for (size_t k = 0; k < ARRAY_TRIAL_PRIMES_COUNT; ++k) {
+            __m512i product =
+                _mm512_mullo_epi64(x, _mm512_set1_epi64(g_array.inverses[k]));
+
+            __mmask8 is_p = _mm512_cmpeq_epu64_mask(
+                x, _mm512_set1_epi64(g_array.primes[k]));
+
+            divisible |= _mm512_mask_cmple_epu64_mask(
+                ~is_p, product, _mm512_set1_epi64(g_array.limits[k]));
+        }
+
+        for (size_t lane = 0; lane < 8; ++lane) {
+            composite[i + lane] = 0 != (divisible & (1 << lane));
+        }
+    }
+
+    trial_divide_scalar(values + i, composite + i, count - i);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Count trailing zeros per lane, 64 for 0
+ */
+__attribute__((target("avx512f,avx512cd"))) static __m512i
+ctz_avx512(__m512i x) {
+    __m512i lowest =
+        _mm512_and_si512(x, _mm512_sub_epi64(_mm512_setzero_si512(), x));
+
+    return _mm512_sub_epi64(_mm512_set1_epi64(63),
+                            _mm512_lzcnt_epi64(lowest));
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Stein's gcd as in gcd_u64, in 8 lanes.
+ * Lanes run until the slowest one is done
+ */
+__attribute__((target("avx512f,avx512cd"))) static void
+gcd_avx512(const uint64_t *a, const uint64_t *b, uint64_t *gcds,
+           size_t count) {
+    const __m512i zero = _mm512_setzero_si512();
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m512i n = _mm512_loadu_si512(a + i);
+        __m512i m = _mm512_loadu_si512(b + i);
+
+        /* gcd(0, m) = m, gcd(n, 0) = n */
+        __mmask8 n_zero = _mm512_cmpeq_epu64_mask(n, zero);
+        __mmask8 m_zero = _mm512_cmpeq_epu64_mask(m, zero);
+        __m512i trivial = _mm512_mask_blend_epi64(n_zero, n, m);
+
+        __m512i shift = ctz_avx512(_mm512_or_si512(n, m));
+        n = _mm512_srlv_epi64(n, ctz_avx512(n));
+
+        __mmask8 active = ~(n_zero | m_zero);
+
+        while (0 != active) {
+            m = _mm512_mask_srlv_epi64(m, active, m, ctz_avx512(m));
+
+            __m512i smaller = _mm512_min_epu64(n, m);
+            __m512i larger = _mm512_max_epu64(n, m);
+
+            n = _mm512_mask_mov_epi64(n, active, smaller);
+            m = _mm512_mask_sub_epi64(m, active, larger, smaller);
+
+            active &= _mm512_cmpneq_epu64_mask(m, zero);
+        }
+
+        __m512i result = _mm512_sllv_epi64(n, shift);
+        result = _mm512_mask_mov_epi64(result, n_zero | m_zero, trivial);
+
+        _mm512_storeu_si512(gcds + i, result);
+    }
+
+    gcd_scalar(a + i, b + i, gcds + i, count - i);
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+static void trial_divide(const uint64_t *values, bool *composite,
+                         size_t count) {
+    STATS_ADD(trial_divisions, count * ARRAY_TRIAL_PRIMES_COUNT);
+
+#ifdef NUMERICS_X86_SIMD
+
+    switch (g_array.simd) {
+        case SIMD_AVX512:
+            trial_divide_avx512(values, composite, count);
+            return;
+
+        case SIMD_AVX2:
+            trial_divide_avx2(values, composite, count);
+            return;
+
+        default:
+            break;
+    }
+
+#endif
+
+    trial_divide_scalar(values, composite, count);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void gcd_u64_array(const uint64_t *a, const uint64_t *b, uint64_t *gcds,
+                   size_t count) {
+    pthread_once(&g_array_once, array_init);
+
+#ifdef NUMERICS_X86_SIMD
+
+    if (SIMD_AVX512 == g_array.simd) {
+        STATS_ADD(gcds, count);
+        gcd_avx512(a, b, gcds, count);
+        return;
+    }
+
+#endif
+
+    gcd_scalar(a, b, gcds, count);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Miller-Rabin with the deterministic bases first_base <= i < end_base on
+ * ARRAY_RABIN_MILLER_LANES odd numbers > 2 at once.
+ * The lanes are independent, interleaving them hides the latency of the
+ * multiplications.
+ */
+static void rabin_miller_lanes(const uint64_t *n, size_t first_base,
+                               size_t end_base, bool *prime) {
+    const size_t lanes = ARRAY_RABIN_MILLER_LANES;
+
+    montgomery_ctx ctx[ARRAY_RABIN_MILLER_LANES];
+    uint64_t d[ARRAY_RABIN_MILLER_LANES];
+    uint64_t s[ARRAY_RABIN_MILLER_LANES];
+    uint64_t minus_one[ARRAY_RABIN_MILLER_LANES];
+
+    uint64_t max_d = 0;
+    uint64_t max_s = 0;
+
+    for (size_t l = 0; l < lanes; ++l) {
+        montgomery_init(ctx + l, n[l]);
+        s[l] = split_off_twos(n[l], d + l);
+        minus_one[l] = ctx[l].n - ctx[l].one;
+        prime[l] = true;
+
+        max_d |= d[l];
+        max_s = (s[l] > max_s) ? s[l] : max_s;
+    }
+
+    const unsigned d_bits = 64 - __builtin_clzll(max_d);
+
+    for (size_t i = first_base; i < end_base; ++i) {
+        uint64_t x[ARRAY_RABIN_MILLER_LANES];
+        uint64_t power[ARRAY_RABIN_MILLER_LANES];
+        bool witness_done[ARRAY_RABIN_MILLER_LANES];
+
+        for (size_t l = 0; l < lanes; ++l) {
+            uint64_t a = DETERMINISTIC_RABIN_MILLER_BASES[i] % n[l];
+
+            x[l] = ctx[l].one;
+            power[l] = montgomery_to(ctx + l, a);
+
+            /* Base is a multiple of n and tells nothing */
+            witness_done[l] = (0 == a) || !prime[l];
+
+            if (!witness_done[l]) {
+                STATS_ADD(rabin_miller_rounds, 1);
+            }
+        }
+
+        /* x = a^d, right to left over the bits of the longest exponent */
+        for (unsigned bit = 0; bit < d_bits; ++bit) {
+            for (size_t l = 0; l < lanes; ++l) {
+                /* Select rather than branch on random exponent bits */
+                uint64_t product = montgomery_mul(ctx + l, x[l], power[l]);
+                x[l] = is_odd(d[l] >> bit) ? product : x[l];
+
+                power[l] = montgomery_square(ctx + l, power[l]);
+            }
+        }
+
+        for (size_t l = 0; l < lanes; ++l) {
+            if ((x[l] == ctx[l].one) || (x[l] == minus_one[l])) {
+                witness_done[l] = true;
+            }
+        }
+
+        for (uint64_t r = 1; r < max_s; ++r) {
+            for (size_t l = 0; l < lanes; ++l) {
+                if (witness_done[l] || (r >= s[l])) continue;
+
+                x[l] = montgomery_square(ctx + l, x[l]);
+
+                if (x[l] == minus_one[l]) {
+                    witness_done[l] = true;
+                }
+            }
+        }
+
+        for (size_t l = 0; l < lanes; ++l) {
+            if (!witness_done[l]) {
+                prime[l] = false;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Numbers waiting for a batch of lanes to become full
+ */
+typedef struct {
+    uint64_t n[ARRAY_RABIN_MILLER_LANES];
+    size_t index[ARRAY_RABIN_MILLER_LANES];
+    size_t count;
+} rabin_miller_queue;
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Most composites fail the first base already.
+ * Thus run the first base on all candidates, and the remaining bases only
+ * on the survivors, which keeps the lanes busy with useful work.
+ */
+static void rabin_miller_push(rabin_miller_queue *first,
+                              rabin_miller_queue *rest, uint64_t n,
+                              size_t index, bool *primes) {
+    const size_t num_bases = sizeof(DETERMINISTIC_RABIN_MILLER_BASES) /
+                             sizeof(DETERMINISTIC_RABIN_MILLER_BASES[0]);
+
+    first->n[first->count] = n;
+    first->index[first->count] = index;
+
+    if (ARRAY_RABIN_MILLER_LANES != ++first->count) {
+        return;
+    }
+
+    bool passed[ARRAY_RABIN_MILLER_LANES];
+    rabin_miller_lanes(first->n, 0, 1, passed);
+    first->count = 0;
+
+    for (size_t l = 0; l < ARRAY_RABIN_MILLER_LANES; ++l) {
+        primes[first->index[l]] = false;
+
+        if (!passed[l]) continue;
+
+        rest->n[rest->count] = first->n[l];
+        rest->index[rest->count] = first->index[l];
+
+        if (ARRAY_RABIN_MILLER_LANES != ++rest->count) {
+            continue;
+        }
+
+        bool prime[ARRAY_RABIN_MILLER_LANES];
+        rabin_miller_lanes(rest->n, 1, num_bases, prime);
+        rest->count = 0;
+
+        for (size_t k = 0; k < ARRAY_RABIN_MILLER_LANES; ++k) {
+            primes[rest->index[k]] = prime[k];
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void is_prime_u64_array(const uint64_t *values, bool *primes, size_t count) {
+    pthread_once(&g_array_once, array_init);
+
+    trial_divide(values, primes, count);
+
+    rabin_miller_queue first = {0};
+    rabin_miller_queue rest = {0};
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t n = values[i];
+
+        if (primes[i]) {
+            /* trial_divide() found a factor */
+            primes[i] = false;
+            continue;
+        }
+
+        if ((n < 2) || is_even(n)) {
+            primes[i] = (2 == n);
+            continue;
+        }
+
+        if (n < ARRAY_TRIAL_PRIMES_LIMIT * ARRAY_TRIAL_PRIMES_LIMIT) {
+            /* No odd factor below the limit, and 2 is in the limit */
+            primes[i] = true;
+            continue;
+        }
+
+        rabin_miller_push(&first, &rest, n, i, primes);
+    }
+
+    /* Leftovers not filling up the lanes */
+    for (size_t l = 0; l < first.count; ++l) {
+        primes[first.index[l]] = is_prime_u64(first.n[l]);
+    }
+
+    for (size_t l = 0; l < rest.count; ++l) {
+        primes[rest.index[l]] = is_prime_u64(rest.n[l]);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void modpow_u64_array(const uint64_t *bases, const uint64_t *exponents,
+                      const uint64_t *moduli, uint64_t *results,
+                      size_t count) {
+    /* Set up Montgomery only once for runs of equal moduli */
+    montgomery_ctx ctx = {0};
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t n = moduli[i];
+
+        if (is_even(n) || (1 == n)) {
+            results[i] = modpow_u64(bases[i], exponents[i], n);
+            continue;
+        }
+
+        if (n != ctx.n) {
+            montgomery_init(&ctx, n);
+        }
+
+        results[i] = montgomery_from(
+            &ctx,
+            montgomery_pow(&ctx, montgomery_to(&ctx, bases[i]), exponents[i]));
+    }
+}
+
+/*****************************************************************************
+                                 RANDOM NUMBERS
+ ****************************************************************************/
+
+/*
+ * As the library function random(3) is not guaranteed to produce more than
+ * 16 bit random numbers, we need to rely on our own prng - it is not that hard
+ * if we do not want cryptographically safe rngs...
+ *
+ * However, this manually implemented PRNG (with a little help by
+ * Mr Donald Knuth) performs better than the currently available
+ * glibc implementation of random(3) under linux
+ *
+ * The Monte Carlo calculation of PI yields results closer to PI by
+ * 1/100, and plotting the points shows an EVEN distribution.
+ *
+ * A better PRNG would be e.g. the Mersenne Twister:
+ *
+ * https://web.archive.org/web/20070918014705/http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/MT2002/CODES/mt19937ar.c
+ *
+ */
+
+/*
+ * Besides the original LCG, there are generators of better quality and
+ * higher throughput:
+ *
+ * xoshiro256** by Blackman and Vigna, https://prng.di.unimi.it
+ * PCG64 (XSL RR 128/64) by O'Neill, https://www.pcg-random.org
+ * Philox4x32-10 by Salmon et al., "Parallel random numbers: As easy as
+ * 1, 2, 3". Being counter based, its blocks are independent of each other
+ * and computed in SIMD lanes by the bulk functions.
+ *
+ * 64 bit generators hand out their upper halves as 32 bit numbers,
+ * 32 bit generators combine two numbers into a 64 bit one, low half first.
+ */
+
+#define RANDOM_DEFAULT_SEED 144312
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/* PCG_DEFAULT_MULTIPLIER_128 and PCG_DEFAULT_INCREMENT_128 of the reference
+ * implementation */
+#define PCG64_MULTIPLIER                                            \
+    (((unsigned __int128)2549297995355413924ull << 64) |            \
+     4865540595714422341ull)
+#define PCG64_DEFAULT_INCREMENT                                     \
+    (((unsigned __int128)6364136223846793005ull << 64) |            \
+     1442695040888963407ull)
+
+/* Every thread has its own default generator, thus threads neither race nor
+ * share cache lines. Threads are told apart by the order they first use
+ * it */
+static _Thread_local rng_state g_rng;
+static _Thread_local uint64_t g_rng_seed = 0;
+static _Thread_local bool g_rng_ready = false;
+static _Thread_local bool g_rng_reseeded = false;
+
+static uint32_t g_rng_threads = 0;
+
+/*----------------------------------------------------------------------------*/
+
+static uint32_t genrand_int32(uint32_t *x) {
+    // This is the general form of a linear congruental method -
+    // with reasonable values for A, B, M
+    // static uint64_t a = ...;
+    // static uint64_t c = ...;
+    // static uint64_t m = ...;
+    // x = (a * x + c) % m;
+
+    // We choose m to be 0xffffffff == UINT32_MAX + 1, then
+    // r mod m is calculated easily by r overflowing on 32 bit
+    // (See Knuth, TAOCP Vol2, 12pp)
+
+    // m = 2^32, hence its only prime factor is '2'
+    // thus, according to TAOCP, 3.2.1.2, Theorem A,
+    // a - 1 should be a multiple of 2
+    // Since m is a multiple of 4, a - 1 should also be a multiple of 4
+    static const uint64_t a = 0xea5f3f01;
+
+    uint64_t r = *x;
+
+    r *= a;
+
+    // This new random number does not really alternate much in the lower order
+    // bits
+    // Thus, we combine the 2 higher order 16 bit chunks in
+    // Does not add randomness, but our PRNG is just for basics
+    // like choosing arbitrary ports...
+
+    uint32_t r1 = (uint32_t)r;
+
+    *x = r1 + (r1 >> 16);
+
+    return *x;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Vigna's splitmix64 - spreads seeds over the state of the larger generators
+ */
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+    return z ^ (z >> 31);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t rotl64(uint64_t x, unsigned k) {
+    return (x << k) | (x >> ((64 - k) & 63));
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t xoshiro256ss_next(uint64_t *s) {
+    const uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotl64(s[3], 45);
+
+    return result;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static unsigned __int128 pcg64_get(const uint64_t *x) {
+    return ((unsigned __int128)x[1] << 64) | x[0];
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void pcg64_set(uint64_t *x, unsigned __int128 value) {
+    x[0] = (uint64_t)value;
+    x[1] = (uint64_t)(value >> 64);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t pcg64_next(rng_state *rng) {
+    unsigned __int128 state = pcg64_get(rng->u.pcg.state);
+
+    state = state * PCG64_MULTIPLIER + pcg64_get(rng->u.pcg.inc);
+    pcg64_set(rng->u.pcg.state, state);
+
+    /* XSL RR output function */
+    uint64_t xored = (uint64_t)(state >> 64) ^ (uint64_t)state;
+    unsigned rotation = (unsigned)(state >> 122);
+
+    return (xored >> rotation) | (xored << ((64 - rotation) & 63));
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Like pcg64_srandom_r of the reference implementation.
+ * sequence has 127 bits, the increment being 2 sequence + 1
+ */
+static void pcg64_seed(rng_state *rng, uint64_t seed,
+                       unsigned __int128 sequence) {
+    pcg64_set(rng->u.pcg.inc, ((unsigned __int128)sequence << 1) | 1);
+    pcg64_set(rng->u.pcg.state, 0);
+
+    pcg64_next(rng);
+
+    pcg64_set(rng->u.pcg.state, pcg64_get(rng->u.pcg.state) + seed);
+
+    pcg64_next(rng);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void philox_block(const uint32_t *counter, const uint32_t *key,
+                         uint32_t *out) {
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (size_t round = 0; round < PHILOX_ROUNDS; ++round) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)p0;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void philox_increment(uint32_t *counter, uint32_t n) {
+    uint64_t carry = n;
+
+    for (size_t i = 0; (0 != carry) && (i < 4); ++i) {
+        carry += counter[i];
+        counter[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+#ifdef NUMERICS_X86_SIMD
+
+/*
+ * The SIMD kernels compute consecutive blocks in lanes of 64 bits, with a
+ * counter word in the lower half each, thus the 32 x 32 bit multiplications
+ * yield the full 64 bit product.
+ * Only the lowest counter word differs between the lanes, the caller makes
+ * sure it does not wrap.
+ */
+
+#define PHILOX_AVX2_BLOCKS 4
+#define PHILOX_AVX512_BLOCKS 8
+
+__attribute__((target("avx2"))) static void
+philox_blocks_avx2(const uint32_t *counter, const uint32_t *key,
+                   uint32_t *out) {
+    const __m256i low = _mm256_set1_epi64x(UINT32_MAX);
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi64x(PHILOX_M1);
+
+    __m256i c0 = _mm256_add_epi64(_mm256_set1_epi64x(counter[0]),
+                                  _mm256_setr_epi64x(0, 1, 2, 3));
+    __m256i c1 = _mm256_set1_epi64x(counter[1]);
+    __m256i c2 = _mm256_set1_epi64x(counter[2]);
+    __m256i c3 = _mm256_set1_epi64x(counter[3]);
+
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (size_t round = 0; round < PHILOX_ROUNDS; ++round) {
+        __m256i p0 = _mm256_mul_epu32(c0, m0);
+        __m256i p1 = _mm256_mul_epu32(c2, m1);
+
+        c0 = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1),
+            _mm256_set1_epi64x(k0));
+        c1 = _mm256_and_si256(p1, low);
+        c2 = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3),
+            _mm256_set1_epi64x(k1));
+        c3 = _mm256_and_si256(p0, low);
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    uint64_t words[4][PHILOX_AVX2_BLOCKS];
+
+    _mm256_storeu_si256((__m256i *)words[0], c0);
+    _mm256_storeu_si256((__m256i *)words[1], c1);
+    _mm256_storeu_si256((__m256i *)words[2], c2);
+    _mm256_storeu_si256((__m256i *)words[3], c3);
+
+    for (size_t block = 0; block < PHILOX_AVX2_BLOCKS; ++block) {
+        for (size_t w = 0; w < 4; ++w) {
+            out[4 * block + w] = (uint32_t)words[w][block];
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+__attribute__((target("avx512f"))) static void
+philox_blocks_avx512(const uint32_t *counter, const uint32_t *key,
+                     uint32_t *out) {
+    const __m512i low = _mm512_set1_epi64(UINT32_MAX);
+    const __m512i m0 = _mm512_set1_epi64(PHILOX_M0);
+    const __m512i m1 = _mm512_set1_epi64(PHILOX_M1);
+
+    __m512i c0 = _mm512_add_epi64(_mm512_set1_epi64(counter[0]),
+                                  _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+    __m512i c1 = _mm512_set1_epi64(counter[1]);
+    __m512i c2 = _mm512_set1_epi64(counter[2]);
+    __m512i c3 = _mm512_set1_epi64(counter[3]);
+
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (size_t round = 0; round < PHILOX_ROUNDS; ++round) {
+        __m512i p0 = _mm512_mul_epu32(c0, m0);
+        __m512i p1 = _mm512_mul_epu32(c2, m1);
+
+        c0 = _mm512_xor_si512(
+            _mm512_xor_si512(_mm512_srli_epi64(p1, 32), c1),
+            _mm512_set1_epi64(k0));
+        c1 = _mm512_and_si512(p1, low);
+        c2 = _mm512_xor_si512(
+            _mm512_xor_si512(_mm512_srli_epi64(p0, 32), c3),
+            _mm512_set1_epi64(k1));
+        c3 = _mm512_and_si512(p0, low);
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    uint64_t words[4][PHILOX_AVX512_BLOCKS];
+
+    _mm512_storeu_si512(words[0], c0);
+    _mm512_storeu_si512(words[1], c1);
+    _mm512_storeu_si512(words[2], c2);
+    _mm512_storeu_si512(words[3], c3);
+
+    for (size_t block = 0; block < PHILOX_AVX512_BLOCKS; ++block) {
+        for (size_t w = 0; w < 4; ++w) {
+            out[4 * block + w] = (uint32_t)words[w][block];
+        }
+    }
+}
+
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Writes 4 * num_blocks numbers, starting at the current counter
+ */
+static void philox_fill_blocks(rng_state *rng, uint32_t *out,
+                               size_t num_blocks) {
+    uint32_t *counter = rng->u.philox.counter;
+    const uint32_t *key = rng->u.philox.key;
+
+#ifdef NUMERICS_X86_SIMD
+
+    const simd_level simd = array_simd_level();
+
+    const size_t lanes = (SIMD_AVX512 == simd)  ? PHILOX_AVX512_BLOCKS
+                         : (SIMD_AVX2 == simd) ? PHILOX_AVX2_BLOCKS
+                                               : 0;
+
+    while ((0 < lanes) && (lanes <= num_blocks)) {
+        if (UINT32_MAX - lanes < counter[0]) {
+            /* Lowest word would wrap within the lanes */
+            philox_block(counter, key, out);
+            philox_increment(counter, 1);
+            out += 4;
+            --num_blocks;
+            continue;
+        }
+
+        if (SIMD_AVX512 == simd) {
+            philox_blocks_avx512(counter, key, out);
+        } else {
+            philox_blocks_avx2(counter, key, out);
+        }
+
+        philox_increment(counter, lanes);
+        out += 4 * lanes;
+        num_blocks -= lanes;
+    }
+
+#endif
+
+    for (; 0 < num_blocks; --num_blocks) {
+        philox_block(counter, key, out);
+        philox_increment(counter, 1);
+        out += 4;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool rng_init_kind(rng_state *rng, rng_kind kind, uint64_t seed) {
+    assert(0 != rng);
+
+    memset(rng, 0, sizeof(*rng));
+    rng->kind = kind;
+
+    uint64_t x = seed;
+
+    switch (kind) {
+        case RNG_LCG32:
+
+            /* 0 is a fixed point of the LCG */
+            rng->u.lcg = (uint32_t)(seed ^ (seed >> 32));
+
+            if (0 == rng->u.lcg) {
+                rng->u.lcg = RANDOM_DEFAULT_SEED;
+            }
+
+            return true;
+
+        case RNG_XOSHIRO256SS:
+
+            /* splitmix64 never yields the forbidden all zero state */
+            for (size_t i = 0; i < 4; ++i) {
+                rng->u.xoshiro[i] = splitmix64(&x);
+            }
+
+            return true;
+
+        case RNG_PCG64:
+
+            /* pcg64_oneseq of the reference implementation */
+            pcg64_seed(rng, seed, PCG64_DEFAULT_INCREMENT >> 1);
+            return true;
+
+        case RNG_PHILOX4X32:
+
+            rng->u.philox.key[0] = (uint32_t)seed;
+            rng->u.philox.key[1] = (uint32_t)(seed >> 32);
+            rng->u.philox.used = 4;
+            return true;
+
+        default:
+
+            rng->kind = RNG_LCG32;
+            rng->u.lcg = RANDOM_DEFAULT_SEED;
+            return false;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void rng_seed(rng_state *rng, uint64_t seed) {
+    rng_init_kind(rng, rng->kind, seed);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void rng_init(rng_state *rng) {
+    rng_init_kind(rng, RNG_LCG32, RANDOM_DEFAULT_SEED);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint32_t philox_next32(rng_state *rng) {
+    if (4 == rng->u.philox.used) {
+        philox_block(rng->u.philox.counter, rng->u.philox.key,
+                     rng->u.philox.block);
+        philox_increment(rng->u.philox.counter, 1);
+        rng->u.philox.used = 0;
+    }
+
+    return rng->u.philox.block[rng->u.philox.used++];
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t rng_next64(rng_state *rng) {
+    switch (rng->kind) {
+        case RNG_XOSHIRO256SS:
+            return xoshiro256ss_next(rng->u.xoshiro);
+
+        case RNG_PCG64:
+            return pcg64_next(rng);
+
+        default:
+            break;
+    }
+
+    uint64_t low = rng_next32(rng);
+    return low | ((uint64_t)rng_next32(rng) << 32);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint32_t rng_next32(rng_state *rng) {
+    switch (rng->kind) {
+        case RNG_XOSHIRO256SS:
+        case RNG_PCG64:
+            return rng_next64(rng) >> 32;
+
+        case RNG_PHILOX4X32:
+            return philox_next32(rng);
+
+        default:
+            return genrand_int32(&rng->u.lcg);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void rng_fill_u32(rng_state *rng, uint32_t *buf, size_t n) {
+    size_t i = 0;
+
+    if (RNG_PHILOX4X32 == rng->kind) {
+        /* Hand out what is left of the current block, then whole blocks
+         * right into buf */
+        for (; (i < n) && (4 != rng->u.philox.used); ++i) {
+            buf[i] = philox_next32(rng);
+        }
+
+        size_t num_blocks = (n - i) / 4;
+        philox_fill_blocks(rng, buf + i, num_blocks);
+        i += 4 * num_blocks;
+    }
+
+    /* Work on local copies of the states - stores to buf could alias them
+     * otherwise */
+    switch (rng->kind) {
+        case RNG_XOSHIRO256SS: {
+            uint64_t state[4];
+            memcpy(state, rng->u.xoshiro, sizeof(state));
+
+            for (; i < n; ++i) {
+                buf[i] = xoshiro256ss_next(state) >> 32;
+            }
+
+            memcpy(rng->u.xoshiro, state, sizeof(state));
+            break;
+        }
+
+        case RNG_PCG64: {
+            rng_state local = *rng;
+
+            for (; i < n; ++i) {
+                buf[i] = pcg64_next(&local) >> 32;
+            }
+
+            *rng = local;
+            break;
+        }
+
+        case RNG_LCG32: {
+            uint32_t x = rng->u.lcg;
+
+            for (; i < n; ++i) {
+                buf[i] = genrand_int32(&x);
+            }
+
+            rng->u.lcg = x;
+            break;
+        }
+
+        default:
+
+            for (; i < n; ++i) {
+                buf[i] = rng_next32(rng);
+            }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void rng_fill_u64(rng_state *rng, uint64_t *buf, size_t n) {
+    switch (rng->kind) {
+        case RNG_XOSHIRO256SS: {
+            uint64_t state[4];
+            memcpy(state, rng->u.xoshiro, sizeof(state));
+
+            for (size_t i = 0; i < n; ++i) {
+                buf[i] = xoshiro256ss_next(state);
+            }
+
+            memcpy(rng->u.xoshiro, state, sizeof(state));
+            return;
+        }
+
+        case RNG_PCG64: {
+            rng_state local = *rng;
+
+            for (size_t i = 0; i < n; ++i) {
+                buf[i] = pcg64_next(&local);
+            }
+
+            *rng = local;
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    /* Pairs of 32 bit numbers, low half first */
+    uint32_t halves[256];
+
+    while (0 < n) {
+        size_t chunk = (n < 128) ? n : 128;
+
+        rng_fill_u32(rng, halves, 2 * chunk);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            buf[i] = halves[2 * i] | ((uint64_t)halves[2 * i + 1] << 32);
+        }
+
+        buf += chunk;
+        n -= chunk;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Maps the upper 53 bits of x, as many as a double holds, onto [0, 1).
+ * Exact, every result is a multiple of 2^-53.
+ */
+static double unit_double(uint64_t x) { return (double)(x >> 11) * 0x1.0p-53; }
+
+/*----------------------------------------------------------------------------*/
+
+double rng_double(rng_state *rng) { return unit_double(rng_next64(rng)); }
+
+/*----------------------------------------------------------------------------*/
+
+void rng_fill_double(rng_state *rng, double *buf, size_t n) {
+    uint64_t bits[256];
+
+    while (0 < n) {
+        size_t chunk = (n < 256) ? n : 256;
+
+        rng_fill_u64(rng, bits, chunk);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            buf[i] = unit_double(bits[i]);
+        }
+
+        buf += chunk;
+        n -= chunk;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Bounded numbers by Lemire, "Fast random integer generation in an
+ * interval": The upper half of x * range is in [0, range).
+ * It is biased only if the lower half falls below 2^w mod range - rejecting
+ * these cases makes it exact, and the division computing 2^w mod range is
+ * only needed if the lower half is below range at all, which is rare for
+ * small ranges.
+ */
+
+static uint32_t bounded32(rng_state *rng, uint32_t x, uint32_t range) {
+    uint64_t m = (uint64_t)x * range;
+
+    if ((uint32_t)m < range) {
+        const uint32_t threshold = (0 - range) % range;
+
+        while ((uint32_t)m < threshold) {
+            m = (uint64_t)rng_next32(rng) * range;
+        }
+    }
+
+    return m >> 32;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static uint64_t bounded64(rng_state *rng, uint64_t x, uint64_t range) {
+    unsigned __int128 m = (unsigned __int128)x * range;
+
+    if ((uint64_t)m < range) {
+        const uint64_t threshold = (0 - range) % range;
+
+        while ((uint64_t)m < threshold) {
+            m = (unsigned __int128)rng_next64(rng) * range;
+        }
+    }
+
+    return m >> 64;
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint32_t rng_bounded32(rng_state *rng, uint32_t range) {
+    uint32_t x = rng_next32(rng);
+    return (0 == range) ? x : bounded32(rng, x, range);
+}
+
+/*----------------------------------------------------------------------------*/
+
+uint64_t rng_bounded64(rng_state *rng, uint64_t range) {
+    uint64_t x = rng_next64(rng);
+    return (0 == range) ? x : bounded64(rng, x, range);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* Raw numbers drawn at once by the bounded fills */
+#define RANDOM_BOUNDED_CHUNK 256
+
+void rng_fill_bounded32(rng_state *rng, uint32_t range, uint32_t *buf,
+                        size_t n) {
+    if (0 == range) {
+        rng_fill_u32(rng, buf, n);
+        return;
+    }
+
+    uint32_t raw[RANDOM_BOUNDED_CHUNK];
+    const uint32_t threshold = (0 - range) % range;
+
+    size_t i = 0;
+
+    while (i < n) {
+        /* Never draw more than n - i numbers - each output takes at least
+         * one, thus the sequence is the same as by single calls */
+        size_t num_raw =
+            (n - i < RANDOM_BOUNDED_CHUNK) ? n - i : RANDOM_BOUNDED_CHUNK;
+
+        rng_fill_u32(rng, raw, num_raw);
+
+        for (size_t k = 0; k < num_raw; ++k) {
+            uint64_t m = (uint64_t)raw[k] * range;
+
+            /* Rejected, draw the replacement in order */
+            while ((uint32_t)m < threshold) {
+                if (num_raw == ++k) break;
+                m = (uint64_t)raw[k] * range;
+            }
+
+            if (num_raw == k) break;
+
+            buf[i++] = m >> 32;
+        }
+    }
 }
 
-/*---------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
-int64_t llmin(int64_t n, int64_t m) {
-    if (n < m) return n;
-    return m;
+void rng_fill_bounded64(rng_state *rng, uint64_t range, uint64_t *buf,
+                        size_t n) {
+    if (0 == range) {
+        rng_fill_u64(rng, buf, n);
+        return;
+    }
+
+    uint64_t raw[RANDOM_BOUNDED_CHUNK];
+    const uint64_t threshold = (0 - range) % range;
+
+    size_t i = 0;
+
+    while (i < n) {
+        size_t num_raw =
+            (n - i < RANDOM_BOUNDED_CHUNK) ? n - i : RANDOM_BOUNDED_CHUNK;
+
+        rng_fill_u64(rng, raw, num_raw);
+
+        for (size_t k = 0; k < num_raw; ++k) {
+            unsigned __int128 m = (unsigned __int128)raw[k] * range;
+
+            while ((uint64_t)m < threshold) {
+                if (num_raw == ++k) break;
+                m = (unsigned __int128)raw[k] * range;
+            }
+
+            if (num_raw == k) break;
+
+            buf[i++] = m >> 64;
+        }
+    }
 }
 
 /*----------------------------------------------------------------------------*/
 
-uint64_t a_raised_to_d_mod_n(uint64_t a, uint64_t d, uint64_t n) {
+uint32_t rng_range(rng_state *rng, uint32_t min, uint32_t max) {
+    if (max == 0) {
+        max = INT_MAX;
+    }
+
+    if (min > max) {
+        return -1;
+    }
 
-    uint64_t m = a;
+    /* range wraps to 0 for the full 32 bits, which rng_bounded32 takes as
+     * 2^32 */
+    return min + rng_bounded32(rng, max - min + 1);
+}
 
-    while (n <= m) {
-        m -= n;
+/*----------------------------------------------------------------------------*/
+
+uint64_t rng_range64(rng_state *rng, uint64_t min, uint64_t max) {
+    if (min > max) {
+        return UINT64_MAX;
     }
 
-    for (uint64_t round = 1; round < d; ++round) {
+    return min + rng_bounded64(rng, max - min + 1);
+}
 
-        assert(m < n);
+/*----------------------------------------------------------------------------*/
 
-        m *= a;
+/*
+ * Normal and exponential distribution by the ziggurat method of Marsaglia
+ * and Tsang, "The Ziggurat Method for Generating Random Variables", with
+ * 256 layers of equal area.
+ *
+ * One 64 bit number gives both the layer (low 8 bits) and the position
+ * within it (upper 53 bits) - the separate bits avoid the correlation
+ * Doornik pointed out for the original.
+ * About 99% of the samples are done after a multiplication and a
+ * comparison.
+ */
 
-        while (n <= m) {
-            m -= n;
-        }
+#define ZIGGURAT_LAYERS 256
+
+/* Right edge of the base layer and area of each layer, for the
+ * unnormalized densities exp(-x^2 / 2) and exp(-x) */
+#define ZIGGURAT_NORMAL_R 3.6541528853610088
+#define ZIGGURAT_NORMAL_V 0.00492867323399
+#define ZIGGURAT_EXPONENTIAL_R 7.69711747013104972
+#define ZIGGURAT_EXPONENTIAL_V 0.0039496598225815571993
+
+typedef struct {
+    /* x[i] right edge of layer i, x[0] the width of the base layer as a
+     * rectangle of the same area, x[ZIGGURAT_LAYERS] = 0 */
+    double x[ZIGGURAT_LAYERS + 1];
+    /* f[i] = density at x[i] */
+    double f[ZIGGURAT_LAYERS + 1];
+} ziggurat_table;
+
+static pthread_once_t g_ziggurat_once = PTHREAD_ONCE_INIT;
+static ziggurat_table g_ziggurat_normal;
+static ziggurat_table g_ziggurat_exponential;
+
+/*----------------------------------------------------------------------------*/
+
+static double normal_density(double x) { return exp(-0.5 * x * x); }
+
+/*----------------------------------------------------------------------------*/
 
-        assert(m < n);
+static double normal_density_inverse(double y) { return sqrt(-2.0 * log(y)); }
+
+/*----------------------------------------------------------------------------*/
+
+static double exponential_density(double x) { return exp(-x); }
+
+/*----------------------------------------------------------------------------*/
+
+static double exponential_density_inverse(double y) { return -log(y); }
+
+/*----------------------------------------------------------------------------*/
+
+static void ziggurat_table_init(ziggurat_table *table, double r, double v,
+                                double (*density)(double),
+                                double (*inverse)(double)) {
+    table->x[0] = v / density(r);
+    table->x[1] = r;
+
+    /* Each layer has area v: x[i] (f(x[i + 1]) - f(x[i])) = v */
+    for (size_t i = 2; i < ZIGGURAT_LAYERS; ++i) {
+        table->x[i] = inverse(v / table->x[i - 1] + density(table->x[i - 1]));
     }
 
-    return m;
+    table->x[ZIGGURAT_LAYERS] = 0;
+
+    for (size_t i = 0; i <= ZIGGURAT_LAYERS; ++i) {
+        table->f[i] = density(table->x[i]);
+    }
 }
 
-/*---------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
-uint64_t greatest_common_divisor(const int64_t n, const int64_t m) {
-    /* Simple algorithm:
-     * Just split smaller number into prime factors and
-     * collect all prime factors in common with bigger number */
-
-    int64_t sfactor = llmin(n, m);
-    int64_t ofactor = llmax(n, m);
-
-    const int64_t max_divisor = 1 + sqrt(sfactor);
-
-    int64_t gcd = 1;
-    int64_t divisor = 2;
-    int64_t sremainder = 1;
-    int64_t oremainder = 1;
-
-    /* Ok, here's the algorithm:
-     *
-     * We got n,m
-     * Assume n < m, otherwise swap (if n == m, n is the gcd)
-     *
-     * There are primes N[i] such that  N[1] * N[2] ... * N[k] = n
-     * There are primes M[i] such that  M[1] * M[2] ... * M[l] = m
-     *
-     * Let {(p[i],q[i])}  (i e [1,r]) the set of index pairs (p[i],q[i])
-     * such that N[p[i]] == M[q[i]]    (p[i] and q[i] being unique).
-     *
-     * Then
-     * gcd := 1 * N[p[1]] ... * N[p[r]]
-     *
-     * NB: r = 0 -> gcd = 1
-     *
-     * REMEMBER:
-     *
-     * If
-     * a[1] * a[2] * ... * a[n] = c
-     *
-     * Then a[i] > sqrt(c) for one single i AT MOST.
-     *
-     * Apart from it being obvious, here's the reason:
-     *
-     * Assume a[I] > sqrt(c) for a particular I =>
-     * c = a[I] * remainder
-     * sqrt(c) * sqrt(c) = a[I] * remainder
-     * =>
-     * remainder = sqrt(c) * sqrt(c) / a[I]
-     * =>
-     * remainder < sqrt(c) * sqrt(c) / sqrt(c) = sqrt(c)
-     *
-     * The while loop will find all factors <= sqrt(n)     (Still assuming n <
-     * m)
-     *
-     * Therefore, in the loop all factors of m <= sqrt(n) will be found.
-     * The only 'edgy' case is n being its own single prime factor.
-     *
-     * We need to treat this case special after the loop.
-     *
-     */
-    while (max_divisor >= divisor) {
-        sremainder = sfactor / divisor;
-
-        if (sfactor != divisor * sremainder) {
-            /* divisor is not a real divisor of sfactor */
-            ++divisor;
-            continue;
+static void ziggurat_init() {
+    ziggurat_table_init(&g_ziggurat_normal, ZIGGURAT_NORMAL_R,
+                        ZIGGURAT_NORMAL_V, normal_density,
+                        normal_density_inverse);
+    ziggurat_table_init(&g_ziggurat_exponential, ZIGGURAT_EXPONENTIAL_R,
+                        ZIGGURAT_EXPONENTIAL_V, exponential_density,
+                        exponential_density_inverse);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Uniform in (0, 1] - safe to take the logarithm of
+ */
+static double positive_unit_double(rng_state *rng) {
+    return 1.0 - rng_double(rng);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static double ziggurat_normal(rng_state *rng) {
+    const ziggurat_table *table = &g_ziggurat_normal;
+
+    for (;;) {
+        const uint64_t bits = rng_next64(rng);
+        const size_t i = bits & (ZIGGURAT_LAYERS - 1);
+
+        /* Symmetric: u in [-1, 1) */
+        const double u = 2.0 * unit_double(bits) - 1.0;
+        const double x = u * table->x[i];
+
+        if (fabs(x) < table->x[i + 1]) {
+            return x;
         }
 
-        sfactor = sremainder;
-        oremainder = ofactor / divisor;
+        if (0 == i) {
+            /* Tail beyond r, by Marsaglia's method */
+            double tail = 0;
+            double y = 0;
+
+            do {
+                tail = -log(positive_unit_double(rng)) / ZIGGURAT_NORMAL_R;
+                y = -log(positive_unit_double(rng));
+            } while (y + y < tail * tail);
 
-        if (ofactor == oremainder * divisor) {
-            gcd *= divisor;
-            ofactor = oremainder;
+            return (u < 0) ? -ZIGGURAT_NORMAL_R - tail
+                           : ZIGGURAT_NORMAL_R + tail;
         }
 
-        if (1 == sremainder) break;
-    }
+        /* In the wedge between the layer and the one above */
+        const double f = table->f[i + 1] +
+                         (table->f[i] - table->f[i + 1]) * rng_double(rng);
 
-    if (sfactor <= max_divisor) {
-        return gcd;
+        if (f < normal_density(x)) {
+            return x;
+        }
     }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static double ziggurat_exponential(rng_state *rng) {
+    const ziggurat_table *table = &g_ziggurat_exponential;
+
+    for (;;) {
+        const uint64_t bits = rng_next64(rng);
+        const size_t i = bits & (ZIGGURAT_LAYERS - 1);
+
+        const double x = unit_double(bits) * table->x[i];
+
+        if (x < table->x[i + 1]) {
+            return x;
+        }
 
-    oremainder = ofactor / sfactor;
+        if (0 == i) {
+            /* The tail of an exponential distribution is a shifted one */
+            return ZIGGURAT_EXPONENTIAL_R - log(positive_unit_double(rng));
+        }
+
+        const double f = table->f[i + 1] +
+                         (table->f[i] - table->f[i + 1]) * rng_double(rng);
 
-    if (ofactor == oremainder * sfactor) {
-        gcd *= sfactor;
+        if (f < exponential_density(x)) {
+            return x;
+        }
     }
+}
 
-    return gcd;
+/*----------------------------------------------------------------------------*/
+
+double rng_normal(rng_state *rng) {
+    pthread_once(&g_ziggurat_once, ziggurat_init);
+    return ziggurat_normal(rng);
 }
 
-/*---------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
-uint64_t smallest_common_multiple(const int64_t n, const int64_t m) {
-    return n * m / greatest_common_divisor(n, m);
+double rng_exponential(rng_state *rng) {
+    pthread_once(&g_ziggurat_once, ziggurat_init);
+    return ziggurat_exponential(rng);
 }
 
 /*----------------------------------------------------------------------------*/
 
-bool is_prime(uint64_t p) {
-    if (2 == p) {
-        return true;
+void rng_fill_normal(rng_state *rng, double *buf, size_t n) {
+    pthread_once(&g_ziggurat_once, ziggurat_init);
+
+    /* Local copy, stores to buf could alias the state otherwise */
+    rng_state local = *rng;
+
+    for (size_t i = 0; i < n; ++i) {
+        buf[i] = ziggurat_normal(&local);
     }
 
-    if (is_even(p)) {
-        return false;
+    *rng = local;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void rng_fill_exponential(rng_state *rng, double *buf, size_t n) {
+    pthread_once(&g_ziggurat_once, ziggurat_init);
+
+    rng_state local = *rng;
+
+    for (size_t i = 0; i < n; ++i) {
+        buf[i] = ziggurat_exponential(&local);
     }
 
-    uint64_t last_factor_to_check = sqrt(p) + 1;
+    *rng = local;
+}
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Jumps and streams.
+ *
+ * A jump advances a generator by a fixed, huge number of steps:
+ *
+ * xoshiro256**  2^128 numbers, long jump 2^192
+ * PCG64         2^64 numbers, long jump 2^96
+ * Philox4x32    2^64 blocks of 4 numbers, long jump 2^96 blocks
+ *
+ * Stream i of a seed is the generator jumped ahead i times, thus streams
+ * never overlap unless a single one is used for more than a jump worth of
+ * numbers.
+ */
 
-    for (uint64_t factor = 2; factor < last_factor_to_check; ++factor) {
-        uint64_t share = p / factor;
+/* Polynomials of the jump functions by Blackman and Vigna */
+static const uint64_t XOSHIRO256_JUMP[4] = {
+    0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+    0x39abdc4529b1661c};
 
-        if (p == share * factor) {
-            return false;
+static const uint64_t XOSHIRO256_LONG_JUMP[4] = {
+    0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241,
+    0x39109bb02acbe635};
+
+/*----------------------------------------------------------------------------*/
+
+static void xoshiro256_jump(uint64_t *s, const uint64_t *polynomial) {
+    uint64_t t[4] = {0};
+
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t b = 0; b < 64; ++b) {
+            if (0 != (polynomial[i] & (1ull << b))) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+
+            xoshiro256ss_next(s);
         }
     }
 
-    return true;
+    memcpy(s, t, sizeof(t));
 }
 
 /*----------------------------------------------------------------------------*/
 
-bool is_large_prime(uint64_t p) {
+/**
+ * Brown, "Random number generation with arbitrary stride":
+ * Applies x -> a x + c delta times in O(log delta)
+ */
+static void pcg64_advance(rng_state *rng, unsigned __int128 delta) {
+    unsigned __int128 multiplier = PCG64_MULTIPLIER;
+    unsigned __int128 increment = pcg64_get(rng->u.pcg.inc);
 
-    if (!passes_rabin_miller(p)) {
-        return false;
+    unsigned __int128 acc_multiplier = 1;
+    unsigned __int128 acc_increment = 0;
+
+    while (0 != delta) {
+        if (is_odd(delta)) {
+            acc_multiplier *= multiplier;
+            acc_increment = acc_increment * multiplier + increment;
+        }
+
+        increment = (multiplier + 1) * increment;
+        multiplier *= multiplier;
+        delta >>= 1;
     }
 
-    return is_prime(p);
+    pcg64_set(rng->u.pcg.state,
+              acc_multiplier * pcg64_get(rng->u.pcg.state) + acc_increment);
 }
 
 /*----------------------------------------------------------------------------*/
 
-bool passes_rabin_miller(uint64_t n) {
-    if (2 == n) {
-        return true;
-    }
+static unsigned __int128 philox_counter_get(const uint32_t *counter) {
+    unsigned __int128 value = 0;
 
-    if (is_even(n)) {
-        return false;
+    for (size_t i = 4; 0 < i; --i) {
+        value = (value << 32) | counter[i - 1];
     }
 
-    uint64_t n_minus_1 = n - 1;
+    return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void philox_counter_set(uint32_t *counter, unsigned __int128 value) {
+    for (size_t i = 0; i < 4; ++i) {
+        counter[i] = (uint32_t)value;
+        value >>= 32;
+    }
+}
 
-    uint64_t twos_exponent = 0;
-    uint64_t twos_factor = 1;
-    uint64_t d = n_minus_1;
+/*----------------------------------------------------------------------------*/
 
-    assert(is_even(d));
+/**
+ * Skips delta numbers
+ */
+static void philox_advance(rng_state *rng, unsigned __int128 delta) {
+    /* Block and offset of the next number handed out - the counter denotes
+     * the block after the buffered one */
+    unsigned __int128 block = philox_counter_get(rng->u.philox.counter);
+    uint32_t offset = rng->u.philox.used % 4;
 
-    for (twos_exponent = 0; is_even(d); ++twos_exponent) {
-        twos_factor *= 2;
-        d /= 2;
+    if (4 != rng->u.philox.used) {
+        --block;
     }
 
-    uint64_t a = random_range(2, n_minus_1);
-    assert(2 <= a);
-    assert(a <= n_minus_1);
+    offset += delta % 4;
+    block += delta / 4 + offset / 4;
+    offset %= 4;
 
-    uint64_t m = a_raised_to_d_mod_n(a, d, n);
+    philox_counter_set(rng->u.philox.counter, block);
+    rng->u.philox.used = 4;
 
-    if (1 == m) return true;
+    if (0 != offset) {
+        philox_next32(rng);
+        rng->u.philox.used = offset;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
 
-    // Now we got our special case:
+static bool rng_jump_by(rng_state *rng, const uint64_t *polynomial,
+                        unsigned pcg_exponent, unsigned philox_exponent) {
+    switch (rng->kind) {
+        case RNG_XOSHIRO256SS:
+            xoshiro256_jump(rng->u.xoshiro, polynomial);
+            return true;
 
-    uint64_t last_m = m;
+        case RNG_PCG64:
+            pcg64_advance(rng, (unsigned __int128)1 << pcg_exponent);
+            return true;
 
-    for (uint64_t r = 0; r < twos_exponent; ++r) {
-        last_m = m;
-        m = a_raised_to_d_mod_n(m, 2, n);
-        if (1 == m) break;
+        case RNG_PHILOX4X32:
+            philox_advance(rng, (unsigned __int128)4 << philox_exponent);
+            return true;
+
+        default:
+            return false;
     }
+}
+
+/*----------------------------------------------------------------------------*/
 
-    return (m == 1) && (n - 1 == last_m);
+bool rng_jump(rng_state *rng) {
+    return rng_jump_by(rng, XOSHIRO256_JUMP, 64, 64);
 }
 
 /*----------------------------------------------------------------------------*/
 
-uint64_t next_prime(const uint64_t n) {
-    for (uint64_t num_to_check = 1 + n; num_to_check < UINT64_MAX;
-         ++num_to_check) {
-        if (is_prime(num_to_check)) {
-            return num_to_check;
-        }
-    }
+bool rng_long_jump(rng_state *rng) {
+    return rng_jump_by(rng, XOSHIRO256_LONG_JUMP, 96, 96);
+}
 
-    return 0;
+/*----------------------------------------------------------------------------*/
+
+bool rng_advance(rng_state *rng, uint64_t delta) {
+    switch (rng->kind) {
+        case RNG_PCG64:
+            pcg64_advance(rng, delta);
+            return true;
+
+        case RNG_PHILOX4X32:
+            philox_advance(rng, delta);
+            return true;
+
+        default:
+            return false;
+    }
 }
 
 /*----------------------------------------------------------------------------*/
 
-uint32_t next_prime_factor(uint64_t n, uint32_t min_factor) {
-    uint64_t last_factor_to_check = sqrt(n) + 1;
+bool rng_stream(rng_state *rng, rng_kind kind, uint64_t seed,
+                uint64_t stream_id) {
+    if ((!rng_init_kind(rng, kind, seed)) || (RNG_LCG32 == kind)) {
+        return false;
+    }
 
-    assert(UINT32_MAX >= last_factor_to_check);
+    switch (kind) {
+        case RNG_XOSHIRO256SS:
 
-    for (uint32_t factor = min_factor; factor < last_factor_to_check;
-         factor = next_prime(factor)) {
-        uint64_t share = n / factor;
+            for (uint64_t i = 0; i < stream_id; ++i) {
+                xoshiro256_jump(rng->u.xoshiro, XOSHIRO256_JUMP);
+            }
 
-        if (n == share * factor) {
-            return (uint32_t)factor;
-        }
+            break;
+
+        case RNG_PCG64:
+            pcg64_advance(rng, (unsigned __int128)stream_id << 64);
+            break;
+
+        default:
+            /* Philox: the upper half of the counter is the stream */
+            rng->u.philox.counter[2] = (uint32_t)stream_id;
+            rng->u.philox.counter[3] = (uint32_t)(stream_id >> 32);
     }
 
-    return 0;
+    return true;
 }
+/*----------------------------------------------------------------------------*/
 
-/*****************************************************************************
-                                 RANDOM NUMBERS
- ****************************************************************************/
+rng_state *rng_default() {
+    if (!g_rng_ready) {
+        /* The first thread gets the seed of old, the others differ */
+        uint32_t thread = __atomic_fetch_add(&g_rng_threads, 1,
+                                             __ATOMIC_RELAXED);
 
-/*
- * As the library function random(3) is not guaranteed to produce more than
- * 16 bit random numbers, we need to rely on our own prng - it is not that hard
- * if we do not want cryptographically safe rngs...
- *
- * However, this manually implemented PRNG (with a little help by
- * Mr Donald Knuth) performs better than the currently available
- * glibc implementation of random(3) under linux
- *
- * The Monte Carlo calculation of PI yields results closer to PI by
- * 1/100, and plotting the points shows an EVEN distribution.
- *
- * A better PRNG would be e.g. the Mersenne Twister:
- *
- * https://web.archive.org/web/20070918014705/http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/MT2002/CODES/mt19937ar.c
- *
- */
+        g_rng_seed = RANDOM_DEFAULT_SEED + (uint64_t)thread * 0x9e3779b9;
+        rng_init_kind(&g_rng, RNG_LCG32, g_rng_seed);
+        g_rng_ready = true;
+    }
 
-static uint32_t g_random_number = 144312;
-static bool g_random_seeded = false;
+    return &g_rng;
+}
 
 /*----------------------------------------------------------------------------*/
 
-static void genrand_init(uint32_t s) { g_random_number = s; }
+bool random_use(rng_kind kind) {
+    rng_default();
+    return rng_init_kind(&g_rng, kind, g_rng_seed);
+}
 
 /*----------------------------------------------------------------------------*/
 
 #include <time.h>
 
-static void genrand_reseed() {
-    if (g_random_seeded) return;
+void random_reseed() {
+    if (g_rng_reseeded) return;
+
+    rng_state *rng = rng_default();
 
-    genrand_init(time(0));
-    g_random_seeded = true;
+    /* Threads reseeding within the same second still differ */
+    g_rng_seed ^= (uint64_t)time(0) << 32;
+    rng_seed(rng, g_rng_seed);
+    g_rng_reseeded = true;
 }
 
 /*----------------------------------------------------------------------------*/
 
-static uint32_t genrand_int32(uint32_t state) {
-    // This is the general form of a linear congruental method -
-    // with reasonable values for A, B, M
-    // static uint64_t a = ...;
-    // static uint64_t c = ...;
-    // static uint64_t m = ...;
-    // g_random_number = (a * g_random_number + c) % m;
+uint32_t random_get32(uint32_t state) {
+    if (0 == state) {
+        return rng_next32(rng_default());
+    }
 
-    // We choose m to be 0xffffffff == UINT32_MAX + 1, then
-    // r mod m is calculated easily by r overflowing on 32 bit
-    // (See Knuth, TAOCP Vol2, 12pp)
+    return genrand_int32(&state);
+}
 
-    // m = 2^32, hence its only prime factor is '2'
-    // thus, according to TAOCP, 3.2.1.2, Theorem A,
-    // a - 1 should be a multiple of 2
-    // Since m is a multiple of 4, a - 1 should also be a multiple of 4
-    static uint64_t a = 0xea5f3f01;
+/*----------------------------------------------------------------------------*/
 
-    uint64_t r = state;
+uint32_t random_range(uint32_t min, uint32_t max) {
+    return rng_range(rng_default(), min, max);
+}
 
-    if (0 == state) {
-        r = g_random_number;
-    }
+/*----------------------------------------------------------------------------*/
 
-    r *= a;
+uint64_t random_range64(uint64_t min, uint64_t max) {
+    return rng_range64(rng_default(), min, max);
+}
 
-    // This new random number does not really alternate much in the lower order
-    // bits
-    // Thus, we do it once more, then combine the 2 higher order 16 bit chunks
-    // into our 'real' number
-    // Does not add randomness, but our PRNG is just for basics
-    // like choosing arbitrary ports...
+/*----------------------------------------------------------------------------*/
 
-    uint32_t r1 = (uint32_t)r;
+void random_fill_u32(uint32_t *buf, size_t n) {
+    rng_fill_u32(rng_default(), buf, n);
+}
 
-    uint64_t r2 = r1;
-    r *= a;
+/*----------------------------------------------------------------------------*/
 
-    uint32_t random_number = r1 + (r2 >> 16);
+void random_fill_u64(uint64_t *buf, size_t n) {
+    rng_fill_u64(rng_default(), buf, n);
+}
 
-    if (0 == state) {
-        g_random_number = random_number;
-    }
+/*----------------------------------------------------------------------------*/
 
-    return random_number;
+void random_fill_double(double *buf, size_t n) {
+    rng_fill_double(rng_default(), buf, n);
 }
 
 /*----------------------------------------------------------------------------*/
 
-void random_reseed() { genrand_reseed(); }
+double random_double() { return rng_double(rng_default()); }
 
 /*----------------------------------------------------------------------------*/
 
-uint32_t random_get32(uint32_t state) { return genrand_int32(state); }
+double random_normal() { return rng_normal(rng_default()); }
 
 /*----------------------------------------------------------------------------*/
 
-uint32_t random_range(uint32_t min, uint32_t max) {
-    if (max == 0) {
-        max = INT_MAX;
-    }
+double random_exponential() { return rng_exponential(rng_default()); }
 
-    if (min > max) {
-        return -1;
-    }
+/*----------------------------------------------------------------------------*/
+
+void random_fill_normal(double *buf, size_t n) {
+    rng_fill_normal(rng_default(), buf, n);
+}
 
-    double r = random_get32(0);
+/*----------------------------------------------------------------------------*/
+
+void random_fill_exponential(double *buf, size_t n) {
+    rng_fill_exponential(rng_default(), buf, n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void random_fill_bounded32(uint32_t range, uint32_t *buf, size_t n) {
+    rng_fill_bounded32(rng_default(), range, buf, n);
+}
 
-    r *= max - min;
-    r /= UINT32_MAX;
+/*----------------------------------------------------------------------------*/
 
-    return min + (uint32_t)r;
+void random_fill_bounded64(uint64_t range, uint64_t *buf, size_t n) {
+    rng_fill_bounded64(rng_default(), range, buf, n);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -41,6 +41,8 @@
 #include <inttypes.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
 
 /*****************************************************************************
                                   Very Basics
@@ -53,32 +55,395 @@ int64_t llmax(int64_t n, int64_t m);
 
 int64_t llmin(int64_t n, int64_t m);
 
+/**
+ * Binary gcd (Stein's algorithm), O(log n) shifts and subtractions.
+ * gcd_u64(0, m) == m
+ */
+uint64_t gcd_u64(uint64_t n, uint64_t m);
+
+/**
+ * Greatest common divisor of |n| and |m|.
+ * greatest_common_divisor(0, m) == |m|
+ */
 uint64_t greatest_common_divisor(const int64_t n, const int64_t m);
 
+/**
+ * Returns g = gcd(|n|, |m|) and sets the Bezout coefficients x, y such that
+ * n * x + m * y = g.
+ * x or y may be 0 if not required.
+ */
+uint64_t extended_greatest_common_divisor(const int64_t n, const int64_t m,
+                                          int64_t *x, int64_t *y);
+
+/**
+ * Least common multiple of |n| and |m|.
+ * Returns 0 if either n or m is 0 or if the result does not fit into
+ * 64 bits.
+ */
 uint64_t smallest_common_multiple(const int64_t n, const int64_t m);
 
+/**
+ * Returns the inverse x of a modulo n, i.e. 0 < x < n with a * x = 1 mod n.
+ * Returns 0 if there is none, i.e. gcd(a, n) != 1 or n < 2.
+ */
+uint64_t modinv_u64(uint64_t a, uint64_t n);
+
+/**
+ * For all i, computes inverses[i] = values[i]^-1 mod n by Montgomery's
+ * trick: One modinv_u64 and 3 (count - 1) multiplications instead of count
+ * extended gcds.
+ * Odd n uses Montgomery multiplication, even n mulmod_u64.
+ *
+ * values and inverses may be the same array.
+ *
+ * Returns false if n < 2, memory could not be allocated or any of the values
+ * is not invertible. In the latter case, the values that are get inverted
+ * one by one nevertheless and the others get 0.
+ */
+bool modinv_batch_u64(const uint64_t *values, uint64_t *inverses,
+                      size_t count, uint64_t n);
+
+/**
+ * Chinese remainder theorem: Finds x with x = residues[i] mod moduli[i] for
+ * all i.
+ * The moduli need not be pairwise coprime, the system is solvable iff the
+ * residues agree modulo the gcds of the moduli.
+ *
+ * On success, sets *modulus to the lcm of the moduli, x to the solution
+ * 0 <= x < *modulus and returns true.
+ * All intermediates are 128 bit, the only limit is the lcm itself.
+ *
+ * Returns false if any modulus is 0, the system has no solution or the lcm
+ * does not fit into 64 bits.
+ * x or modulus may be 0 if not required.
+ */
+bool crt_u64(const uint64_t *residues, const uint64_t *moduli, size_t count,
+             uint64_t *x, uint64_t *modulus);
+
+/**
+ * For all i, computes gcds[i] = gcd(values[i], product of all other values)
+ * by Bernstein's product / remainder trees in quasi-linear time, instead of
+ * O(count^2) pairwise gcds.
+ *
+ * gcds[i] != 1 iff values[i] shares a factor with any of the other values.
+ *
+ * values must not contain 0.
+ * Returns false if it does or memory could not be allocated.
+ */
+bool batch_gcd_u64(const uint64_t *values, size_t count, uint64_t *gcds);
+
+/*****************************************************************************
+                              Modular arithmetic
+ ****************************************************************************/
+
+/**
+ * Returns a * b mod n.
+ * Uses a 128 bit intermediate product, hence works for all n < 2^64.
+ * n must not be 0.
+ */
+uint64_t mulmod_u64(uint64_t a, uint64_t b, uint64_t n);
+
+/**
+ * Returns a^d mod n by square-and-multiply, O(log d) multiplications.
+ * Overflow-safe for all n < 2^64.
+ * n must not be 0. a^0 mod n is 1 mod n.
+ */
+uint64_t modpow_u64(uint64_t a, uint64_t d, uint64_t n);
+
+/*****************************************************************************
+                             Montgomery arithmetic
+ ****************************************************************************/
+
+/**
+ * Precomputed values for doing division free modular arithmetic against one
+ * odd modulus n, with R = 2^64.
+ *
+ * Numbers are converted into montgomery form aR mod n once, then multiplied
+ * without any division, and converted back once at the end.
+ * Worthwhile whenever many operations are done against the same modulus.
+ */
+typedef struct {
+    uint64_t n;
+    /* n^-1 mod R */
+    uint64_t n_inv;
+    /* R^2 mod n - used to convert into montgomery form */
+    uint64_t r2;
+    /* R mod n - the number 1 in montgomery form */
+    uint64_t one;
+} montgomery_ctx;
+
+/**
+ * Sets up ctx for modulus n.
+ * n must be odd and greater than 1.
+ * Returns false if n is not suitable.
+ */
+bool montgomery_init(montgomery_ctx *ctx, uint64_t n);
+
+/**
+ * Converts a into montgomery form.
+ * a need not be reduced mod n.
+ */
+uint64_t montgomery_to(const montgomery_ctx *ctx, uint64_t a);
+
+/**
+ * Converts a from montgomery form back into an ordinary residue in [0, n)
+ */
+uint64_t montgomery_from(const montgomery_ctx *ctx, uint64_t a);
+
+/**
+ * Multiplies a and b, both in montgomery form.
+ * Result is in montgomery form, too.
+ */
+uint64_t montgomery_mul(const montgomery_ctx *ctx, uint64_t a, uint64_t b);
+
+uint64_t montgomery_square(const montgomery_ctx *ctx, uint64_t a);
+
+/**
+ * Returns a^d, a and the result being in montgomery form
+ */
+uint64_t montgomery_pow(const montgomery_ctx *ctx, uint64_t a, uint64_t d);
+
 /*****************************************************************************
                                     Random..
  ****************************************************************************/
 
+typedef enum {
+    /* The original linear congruential generator, 32 bit state.
+     * Fine for picking ports, not for simulations */
+    RNG_LCG32 = 0,
+    /* xoshiro256** - fast, 256 bit state, period 2^256 - 1 */
+    RNG_XOSHIRO256SS,
+    /* PCG64 XSL RR - 128 bit LCG with permuted output */
+    RNG_PCG64,
+    /* Philox4x32-10 - counter based, bulk generation is vectorized */
+    RNG_PHILOX4X32,
+} rng_kind;
+
+/**
+ * State of one pseudo random number generator.
+ * A state must not be used by several threads at once - give every thread
+ * its own one.
+ * Members are private.
+ */
+typedef struct {
+    rng_kind kind;
+
+    union {
+        uint32_t lcg;
+        uint64_t xoshiro[4];
+
+        struct {
+            /* 128 bit numbers, low half first */
+            uint64_t state[2];
+            uint64_t inc[2];
+        } pcg;
+
+        struct {
+            uint32_t counter[4];
+            uint32_t key[2];
+            /* Current block and how many numbers of it are handed out */
+            uint32_t block[4];
+            uint32_t used;
+        } philox;
+    } u;
+} rng_state;
+
+/**
+ * Sets rng up as RNG_LCG32 with the default seed - the sequence is the same
+ * on every run
+ */
+void rng_init(rng_state *rng);
+
+/**
+ * Sets rng up as generator of kind, seeded by seed.
+ * Equal seeds give equal sequences.
+ * Returns false for an unknown kind, rng is set up as RNG_LCG32 then.
+ */
+bool rng_init_kind(rng_state *rng, rng_kind kind, uint64_t seed);
+
+/**
+ * Reseeds rng, keeping its kind
+ */
+void rng_seed(rng_state *rng, uint64_t seed);
+
+uint32_t rng_next32(rng_state *rng);
+
+uint64_t rng_next64(rng_state *rng);
+
+/*
+ * Bulk generation.
+ * Fill buf with n random numbers - the same as n calls to rng_next32 /
+ * rng_next64 would return, only faster.
+ */
+
+void rng_fill_u32(rng_state *rng, uint32_t *buf, size_t n);
+
+void rng_fill_u64(rng_state *rng, uint64_t *buf, size_t n);
+
+/**
+ * Uniformly distributed doubles in [0, 1), 53 random bits each
+ */
+void rng_fill_double(rng_state *rng, double *buf, size_t n);
+
+/**
+ * Uniformly distributed double in [0, 1), 53 random bits, no division
+ */
+double rng_double(rng_state *rng);
+
+/**
+ * Standard normal distribution, mean 0 and variance 1.
+ * Scale by sigma and add mu for others.
+ * Ziggurat method, one 64 bit number per sample mostly.
+ */
+double rng_normal(rng_state *rng);
+
+/**
+ * Exponential distribution with rate 1.
+ * Divide by lambda for other rates.
+ * Ziggurat method, one 64 bit number per sample mostly.
+ */
+double rng_exponential(rng_state *rng);
+
+void rng_fill_normal(rng_state *rng, double *buf, size_t n);
+
+void rng_fill_exponential(rng_state *rng, double *buf, size_t n);
+
+/**
+ * Returns a random number in the range of min <= rand <= max.
+ * See random_range.
+ */
+uint32_t rng_range(rng_state *rng, uint32_t min, uint32_t max);
+
+/**
+ * Returns a random number in the range of min <= rand <= max.
+ * Returns UINT64_MAX if min > max.
+ */
+uint64_t rng_range64(rng_state *rng, uint64_t min, uint64_t max);
+
+/*
+ * Uniformly distributed numbers in [0, range), without bias and mostly
+ * without division (Lemire's method).
+ * range == 0 stands for the full 2^32 / 2^64.
+ *
+ * The fill functions give the same numbers as single calls would.
+ */
+
+uint32_t rng_bounded32(rng_state *rng, uint32_t range);
+
+uint64_t rng_bounded64(rng_state *rng, uint64_t range);
+
+void rng_fill_bounded32(rng_state *rng, uint32_t range, uint32_t *buf,
+                        size_t n);
+
+void rng_fill_bounded64(rng_state *rng, uint64_t range, uint64_t *buf,
+                        size_t n);
+
+/*
+ * Disjoint streams for parallel runs.
+ *
+ * rng_jump advances rng by a fixed, huge number of steps - 2^128 for
+ * RNG_XOSHIRO256SS, 2^64 for RNG_PCG64, 2^66 for RNG_PHILOX4X32.
+ * rng_long_jump by 2^192, 2^96, 2^98 respectively.
+ *
+ * rng_stream(rng, kind, seed, i) sets rng up as rng_init_kind(rng, kind,
+ * seed) jumped ahead i times. Thus streams do not overlap, and a stream
+ * gives the same numbers no matter which thread or process uses it.
+ * Hand out streams per work item rather than per thread to get identical
+ * results regardless of the number of threads.
+ * For RNG_XOSHIRO256SS, this costs O(stream_id).
+ *
+ * RNG_LCG32 supports none of these, the functions return false for it.
+ */
+
+bool rng_jump(rng_state *rng);
+
+bool rng_long_jump(rng_state *rng);
+
+bool rng_stream(rng_state *rng, rng_kind kind, uint64_t seed,
+                uint64_t stream_id);
+
+/**
+ * Skips the next delta numbers rng_next32 would return, in O(log delta).
+ * Supported by RNG_PCG64 and RNG_PHILOX4X32 only, returns false otherwise.
+ */
+bool rng_advance(rng_state *rng, uint64_t delta);
+
+/**
+ * The generator of the calling thread, which random_get32(0),
+ * random_range and passes_rabin_miller use.
+ * Every thread gets its own, seeded differently, no locking required.
+ * The pointer must not be handed to other threads.
+ */
+rng_state *rng_default();
+
+/**
+ * Switches the generator of the calling thread to kind, seeded as it was
+ * originally.
+ * The default is RNG_LCG32.
+ * Returns false for an unknown kind.
+ */
+bool random_use(rng_kind kind);
+
+/**
+ * Seeds the generator of the calling thread by the current time.
+ * Only the first call per thread has an effect.
+ */
 void random_reseed();
 
 /**
  * Returns a random number
  * If state is given, it is used as seed for the PRNG.
- * If it is not given, uses internal seed.
+ * If it is not given, uses the generator of the calling thread,
+ * see rng_default.
  *
- * For multithreaded environments, its best to use the seed.
- * Store the random number returned and use it as seed the next time you call
- * this function.
+ * Prefer a rng_state of your own over passing states here.
  */
 uint32_t random_get32(uint32_t state);
 
 /**
  * Returns a random number in the range of min <= rand <= max
+ * from the generator of the calling thread.
+ * Every number in the range is equally likely.
+ * max == 0 is taken as INT_MAX, min > max returns (uint32_t)-1.
  */
 uint32_t random_range(uint32_t min, uint32_t max);
 
+/**
+ * Like random_range, for 64 bit.
+ * There is no special meaning to max == 0, min > max returns UINT64_MAX.
+ */
+uint64_t random_range64(uint64_t min, uint64_t max);
+
+/*
+ * Bulk generation from the generator of the calling thread,
+ * see rng_fill_u32 etc.
+ */
+
+void random_fill_u32(uint32_t *buf, size_t n);
+
+void random_fill_u64(uint64_t *buf, size_t n);
+
+void random_fill_double(double *buf, size_t n);
+
+/*
+ * Sampling from the generator of the calling thread,
+ * see rng_double etc.
+ */
+
+double random_double();
+
+double random_normal();
+
+double random_exponential();
+
+void random_fill_normal(double *buf, size_t n);
+
+void random_fill_exponential(double *buf, size_t n);
+
+void random_fill_bounded32(uint32_t range, uint32_t *buf, size_t n);
+
+void random_fill_bounded64(uint64_t range, uint64_t *buf, size_t n);
+
 /*****************************************************************************
                                      Primes
  ****************************************************************************/
@@ -91,25 +456,27 @@ bool is_prime(uint64_t p);
 
 /**
  * Can be used for large numbers.
- * Will try to filter out non-primes by applying the rabin-miller test
- * several times on them.
- * For primes, will be actually slower than the is_prime test.
- *
- * Since the rabin miller test in here for primes up to at least 100000
- * is much slower than just brute force prime checking, it's more of
- * a demo.
+ * Deterministic for the entire range of uint64_t, see is_prime_u64.
  */
 bool is_large_prime(uint64_t p);
 
+/**
+ * Deterministic prime test for all 64 bit numbers.
+ * Pre-filters by small primes, then runs the rabin miller test for a fixed
+ * set of 7 bases that is known to have no strong pseudoprime below 2^64.
+ *
+ * Costs a few dozen modular multiplications at most, no trial division.
+ */
+bool is_prime_u64(uint64_t n);
+
 /**
  * All primes must pass this test.
  * Albeit not all non-primes do not pass it.
  *
  * The test internally uses a randomly selected number to check.
+ * Costs O(log n) modular multiplications.
  *
- * This function is not performant and merely a demo.
- *
- * But if it was performant, we could use it on large numbers to either
+ * It can be used on large numbers to either
  *
  * (1) Check ahead of doing the actual full prime test whether we can rule the
  * number out in advance (2) If we only require a 'likely' prime, we can pass it
@@ -124,8 +491,407 @@ uint64_t next_prime(const uint64_t n);
 
 /**
  * Returns the next prime factor of n greater than min or 0 if something went
- * wrong
+ * wrong.
+ * min_factor itself is returned if it divides n.
  */
 uint32_t next_prime_factor(uint64_t n, uint32_t min_factor);
 
+/**
+ * A number < 2^64 has at most 15 distinct prime factors
+ */
+#define FACTORIZE_MAX_FACTORS 15
+
+/**
+ * Splits n into its prime factors.
+ * The distinct prime factors are written to factors in ascending order,
+ * their multiplicities to exponents.
+ * Both arrays must provide room for FACTORIZE_MAX_FACTORS entries.
+ *
+ * Strips small factors by trial division, then uses Pollard-Brent rho.
+ *
+ * Returns the number of distinct prime factors, 0 for n < 2.
+ */
+size_t factorize_u64(uint64_t n, uint64_t *factors, uint32_t *exponents);
+
+/**
+ * Callback for functions enumerating primes.
+ * Return false to stop the enumeration.
+ */
+typedef bool (*prime_callback)(uint64_t prime, void *ctx);
+
+/*****************************************************************************
+                                  Prime table
+ ****************************************************************************/
+
+/*
+ * A table of all primes up to some limit, stored as a bitmap compressed by a
+ * mod 30 wheel (30 numbers per byte).
+ *
+ * Once built, is_prime, next_prime and next_prime_factor consult it
+ * for all arguments within the table.
+ *
+ * Tables can be stored by prime_table_save, e.g. by bin/prime_table_gen,
+ * and loaded by prime_table_load.
+ * Loaded tables are mapped read-only, thus building them is paid for once,
+ * and all processes using the same file share the memory.
+ *
+ * Building / freeing the table is not thread safe,
+ * reading from it concurrently is.
+ */
+
+/**
+ * Builds the table for all numbers <= limit, replacing any previous table.
+ * Requires about limit / 30 bytes.
+ * Returns false if memory could not be allocated.
+ */
+bool prime_table_init(uint64_t limit);
+
+void prime_table_free();
+
+/**
+ * Writes the current table to path.
+ * Returns false if there is no table or writing failed.
+ */
+bool prime_table_save(const char *path);
+
+/**
+ * Replaces the current table by the one stored in path by prime_table_save.
+ * Returns false if the file could not be mapped or holds no valid table of
+ * this version, leaving the current table in place.
+ */
+bool prime_table_load(const char *path);
+
+/**
+ * Returns the highest number covered by the table, 0 if there is none
+ */
+uint64_t prime_table_limit();
+
+/**
+ * O(1) prime test.
+ * Returns false for p beyond the table limit.
+ */
+bool prime_table_is_prime(uint64_t p);
+
+/**
+ * Returns the smallest prime greater than n, or 0 if it is beyond the table
+ */
+uint64_t prime_table_next(uint64_t n);
+
+/**
+ * Returns the n-th prime (prime_table_nth(1) == 2), or 0 if it is beyond the
+ * table.
+ */
+uint64_t prime_table_nth(uint64_t n);
+
+/**
+ * Calls callback for all primes lo <= p < hi in the table, ascending.
+ * Returns the number of primes passed to callback.
+ */
+uint64_t prime_table_foreach(uint64_t lo, uint64_t hi, prime_callback callback,
+                             void *ctx);
+
+/*****************************************************************************
+                                 Prime ranges
+ ****************************************************************************/
+
+/**
+ * Calls callback for all primes lo <= p < hi, ascending.
+ * Works for any window within uint64_t.
+ *
+ * Segmented sieve: Requires O(sqrt(hi)) memory, independent of the width of
+ * the window. Uses the prime table if it covers the window.
+ *
+ * Returns the number of primes passed to callback, 0 if memory could not be
+ * allocated.
+ */
+uint64_t prime_range_foreach(uint64_t lo, uint64_t hi, prime_callback callback,
+                             void *ctx);
+
+/**
+ * Writes the primes lo <= p < hi into buffer, ascending, until either all are
+ * written or buffer is full.
+ * Returns the number of primes written.
+ */
+size_t prime_range_fill(uint64_t lo, uint64_t hi, uint64_t *buffer,
+                        size_t capacity);
+
+/**
+ * Like prime_range_foreach, but sieves with num_threads worker threads.
+ * num_threads == 0 uses one thread per online CPU.
+ *
+ * callback is called from the calling thread only, with the primes in
+ * ascending order.
+ * Falls back to prime_range_foreach for windows too small to be worth it.
+ * If the threads run out of memory, the rest of the window is sieved
+ * sequentially after the last prime reported, so no prime is skipped or
+ * reported twice.
+ */
+uint64_t prime_range_foreach_parallel(uint64_t lo, uint64_t hi,
+                                      size_t num_threads,
+                                      prime_callback callback, void *ctx);
+
+#ifdef NUMERICS_FAULT_INJECTION
+
+/**
+ * For testing: the chunk numbered chunk of every following
+ * prime_range_foreach_parallel fails as if memory had run out.
+ * UINT64_MAX turns it off again.
+ */
+void numerics_fault_parallel_sieve(uint64_t chunk);
+
+#endif
+
+typedef struct {
+    uint64_t count;
+    /* Sum of all primes, as 128 bit number */
+    uint64_t sum_high;
+    uint64_t sum_low;
+} prime_range_totals;
+
+/**
+ * Counts and sums up the primes lo <= p < hi with num_threads worker threads.
+ * num_threads == 0 uses one thread per online CPU.
+ */
+bool prime_range_totals_parallel(uint64_t lo, uint64_t hi, size_t num_threads,
+                                 prime_range_totals *totals);
+
+/*****************************************************************************
+                                 Prime iterator
+ ****************************************************************************/
+
+/**
+ * Walks along the primes in either direction, from any start.
+ *
+ * Keeps a sieved window around the current position and a cache of base
+ * primes, thus consecutive primes cost amortized O(log log n) each,
+ * instead of a prime test for every candidate.
+ * Memory stays below 1 MiB.
+ *
+ * Members are private.
+ */
+typedef struct {
+    /* Next candidates for next / prev, inclusive */
+    uint64_t next_from;
+    uint64_t prev_from;
+
+    /* Sieved window: bit i set iff lo + 2i is composite */
+    uint64_t *bits;
+    uint64_t capacity;
+    uint64_t lo;
+    uint64_t num_bits;
+    /* Size of the next window */
+    uint64_t window_bits;
+    /* Window sieved only partially, candidates need to be tested */
+    bool verify;
+    /* Last step ran out of memory */
+    bool failed;
+
+    /* Odd primes <= base_max */
+    uint32_t *base_primes;
+    size_t num_base_primes;
+    uint64_t base_max;
+} prime_iterator;
+
+/**
+ * Sets it up at start: The first prime_iterator_next returns the smallest
+ * prime >= start, the first prime_iterator_prev the largest prime <= start.
+ * Memory is allocated on demand by the steps, thus always returns true.
+ * Release with prime_iterator_free.
+ */
+bool prime_iterator_init(prime_iterator *it, uint64_t start);
+
+/**
+ * Returns the next prime, 0 beyond the largest prime below 2^64 or if memory
+ * could not be allocated
+ */
+uint64_t prime_iterator_next(prime_iterator *it);
+
+/**
+ * Returns the previous prime, 0 below 2 or if memory could not be allocated
+ */
+uint64_t prime_iterator_prev(prime_iterator *it);
+
+/**
+ * Whether the last prime_iterator_next / prime_iterator_prev returned 0
+ * because memory could not be allocated rather than for running out of
+ * primes.
+ * The position is kept then, the step can be retried.
+ */
+bool prime_iterator_failed(const prime_iterator *it);
+
+/**
+ * Moves it to start, as if set up by prime_iterator_init, but keeps its
+ * caches
+ */
+void prime_iterator_skip_to(prime_iterator *it, uint64_t start);
+
+void prime_iterator_free(prime_iterator *it);
+
+/*****************************************************************************
+                                 Prime counting
+ ****************************************************************************/
+
+/**
+ * Returns pi(x), the number of primes <= x.
+ *
+ * Looked up if the prime table covers x, otherwise counted by
+ * Lucy_Hedgehog's method in O(x^(3/4)) time and about 8 sqrt(x) bytes,
+ * i.e. about a second for 10^12, and 80 MB of memory for 10^14.
+ * Returns 0 if memory could not be allocated.
+ */
+uint64_t prime_count(uint64_t x);
+
+/**
+ * Returns the n-th prime, nth_prime(1) == 2.
+ * Costs a few prime_count around the expected result.
+ * Returns 0 for n == 0, if the n-th prime is beyond uint64_t or if memory
+ * could not be allocated.
+ */
+uint64_t nth_prime(uint64_t n);
+
+/*****************************************************************************
+                              Arithmetic functions
+ ****************************************************************************/
+
+/**
+ * Output arrays for the multiplicative functions of a range of numbers.
+ * Any of them may be 0 if not required, it is skipped then.
+ * All of them are 0 for n == 0.
+ */
+typedef struct {
+    /* Euler's totient: The number of 1 <= k <= n coprime to n */
+    uint64_t *phi;
+    /* Moebius function: 0 if n has a square factor, (-1)^omega(n) otherwise */
+    int8_t *mu;
+    /* Number of divisors */
+    uint32_t *tau;
+    /* Sum of divisors */
+    uint64_t *sigma;
+    /* Number of distinct prime factors */
+    uint8_t *omega;
+} arithmetic_functions;
+
+/**
+ * Fills the arrays of f for all 0 <= n < limit, entry n.
+ *
+ * Linear (Euler) sieve: Every composite is reached exactly once, from its
+ * smallest prime factor, hence O(limit) time.
+ * Requires about 4 limit bytes beside the arrays, 8 if tau or sigma are
+ * requested.
+ *
+ * Returns false if limit > 2^32 or memory could not be allocated.
+ */
+bool arithmetic_functions_sieve(uint64_t limit, const arithmetic_functions *f);
+
+/**
+ * Fills the arrays of f for all lo <= n < hi, entry n - lo.
+ *
+ * Segmented for windows anywhere within uint64_t: Divides out the primes up
+ * to sqrt(hi) segment by segment, O((hi - lo) log log hi) time and
+ * O(sqrt(hi)) memory beside the arrays.
+ * Large N can be covered window by window.
+ * Windows far narrower than sqrt(hi) are factorized number by number
+ * instead.
+ *
+ * Returns false if memory could not be allocated, or sigma is requested and
+ * hi > 2^61 - sigma(n) might not fit into 64 bits beyond.
+ */
+bool arithmetic_functions_range(uint64_t lo, uint64_t hi,
+                                const arithmetic_functions *f);
+
+/*****************************************************************************
+                                    Arrays
+ ****************************************************************************/
+
+/*
+ * Element wise versions of the scalar functions over contiguous buffers of
+ * count elements each, giving the same results as calling them one by one.
+ *
+ * Kernels use AVX2 / AVX-512 if the CPU supports them, with a scalar
+ * fallback. The environment variable NUMERICS_SIMD set to "none" or "avx2"
+ * restricts the choice.
+ * Output buffers must not overlap the inputs.
+ */
+
+/**
+ * gcds[i] = gcd_u64(a[i], b[i])
+ */
+void gcd_u64_array(const uint64_t *a, const uint64_t *b, uint64_t *gcds,
+                   size_t count);
+
+/**
+ * primes[i] = is_prime_u64(values[i])
+ */
+void is_prime_u64_array(const uint64_t *values, bool *primes, size_t count);
+
+/**
+ * results[i] = modpow_u64(bases[i], exponents[i], moduli[i]).
+ * Runs of equal moduli share their Montgomery setup - sort by modulus if
+ * possible.
+ * moduli must not contain 0.
+ */
+void modpow_u64_array(const uint64_t *bases, const uint64_t *exponents,
+                      const uint64_t *moduli, uint64_t *results,
+                      size_t count);
+
+/*****************************************************************************
+                                  Statistics
+ ****************************************************************************/
+
+/*
+ * Hot path counters to see where the time goes inside the primality and gcd
+ * engines.
+ *
+ * They are compiled in only if numerics.c is built with -DNUMERICS_STATS -
+ * otherwise they cost nothing and stay 0.
+ * -DNUMERICS_STATS_CYCLES additionally times the entry points listed in
+ * numerics_timer, in TSC cycles on x86-64 and nanoseconds elsewhere.
+ *
+ * Counters are per thread, every thread only sees the work it did itself.
+ */
+
+typedef enum {
+    NUMERICS_TIMER_IS_PRIME,
+    NUMERICS_TIMER_PASSES_RABIN_MILLER,
+    NUMERICS_TIMER_NEXT_PRIME,
+    NUMERICS_TIMER_GREATEST_COMMON_DIVISOR,
+    NUMERICS_TIMERS,
+} numerics_timer;
+
+typedef struct {
+    /* Candidate divisors tried by trial division */
+    uint64_t trial_divisions;
+    /* Modular multiplications and squarings, Montgomery or not */
+    uint64_t modmuls;
+    /* Strong probable prime tests, one per number and base */
+    uint64_t rabin_miller_rounds;
+    /* is_prime / next_prime queries answered by the prime table */
+    uint64_t sieve_hits;
+    /* gcds computed, including those of gcd_u64_array */
+    uint64_t gcds;
+    /* Calls of the timed entry points and the ticks spent inside them.
+     * Nested calls are included, e.g. next_prime contains the is_prime calls
+     * it makes. ticks are counted with NUMERICS_STATS_CYCLES only */
+    uint64_t calls[NUMERICS_TIMERS];
+    uint64_t ticks[NUMERICS_TIMERS];
+} numerics_stats;
+
+/**
+ * Copies the counters of the calling thread to stats.
+ * Returns false if the library was built without NUMERICS_STATS, stats is
+ * all 0 then.
+ */
+bool numerics_stats_snapshot(numerics_stats *stats);
+
+/**
+ * Sets the counters of the calling thread to 0
+ */
+void numerics_stats_reset();
+
+/**
+ * Writes stats to out, one counter per line.
+ * If stats is 0, the counters of the calling thread are written.
+ */
+void numerics_stats_dump(FILE *out, const numerics_stats *stats);
+
 #endif /* __NUMERICS_H__ */
@@ -0,0 +1,638 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+
+/*
+ * Micro benchmarks for numerics.h:
+ *
+ *     numerics_bench [-f text|csv|json] [-r REPS] [-w WARMUP] [FILTER]
+ *
+ * Every benchmark runs over a batch of pre-generated inputs from one of
+ * several distributions. The number of passes over the batch is calibrated
+ * such that one repetition takes at least BENCH_MIN_REP_NS.
+ * After WARMUP repetitions, REPS repetitions are timed and their spread is
+ * reported as ns per operation.
+ *
+ * Only benchmarks whose name contains FILTER are run.
+ * CSV and JSON output are meant to be diffed between runs.
+ */
+#include "numerics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define BENCH_BATCH 256
+#define BENCH_DEFAULT_REPS 31
+#define BENCH_DEFAULT_WARMUP 3
+#define BENCH_MIN_REP_NS 2000000ull
+
+typedef enum {
+    INPUT_NONE = 0,
+    /* [2, 2^16) */
+    INPUT_SMALL,
+    /* [2^16, 2^32) */
+    INPUT_MEDIUM,
+    /* [2^32, 2^64) */
+    INPUT_U64,
+    INPUT_KINDS,
+} input_kind;
+
+static const char *INPUT_NAMES[INPUT_KINDS] = {"none", "small", "medium",
+                                               "u64"};
+
+#define INPUT_BIT(kind) (1u << (kind))
+#define INPUT_UP_TO_32 (INPUT_BIT(INPUT_SMALL) | INPUT_BIT(INPUT_MEDIUM))
+#define INPUT_ALL (INPUT_UP_TO_32 | INPUT_BIT(INPUT_U64))
+
+typedef struct {
+    uint64_t a[BENCH_BATCH];
+    uint64_t b[BENCH_BATCH];
+    /* Odd numbers >= 5, for primality */
+    uint64_t odd[BENCH_BATCH];
+} inputs;
+
+/**
+ * Runs the operation once per input, returns something depending on all
+ * results to keep the compiler from dropping the calls
+ */
+typedef uint64_t (*bench_function)(const inputs *in, uint64_t param);
+
+typedef struct {
+    const char *name;
+    bench_function run;
+    uint64_t param;
+    /* INPUT_BIT of all applicable input kinds, 0 for none */
+    unsigned inputs;
+} benchmark;
+
+typedef struct {
+    const char *name;
+    const char *input;
+    size_t reps;
+    uint64_t ops_per_rep;
+    double min;
+    double p10;
+    double median;
+    double p90;
+    double p99;
+    double max;
+} result;
+
+typedef enum { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON } format;
+
+/*---------------------------------------------------------------------------*/
+
+static volatile uint64_t g_sink = 0;
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t now_ns() {
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void inputs_generate(inputs *in, input_kind kind, rng_state *rng) {
+    static const uint64_t LOWER[INPUT_KINDS] = {0, 2, 1ull << 16, 1ull << 32};
+    static const uint64_t UPPER[INPUT_KINDS] = {0, (1ull << 16) - 1,
+                                                (1ull << 32) - 1, UINT64_MAX};
+
+    if (INPUT_NONE == kind) {
+        memset(in, 0, sizeof(*in));
+        return;
+    }
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        in->a[i] = rng_range64(rng, LOWER[kind], UPPER[kind]);
+        in->b[i] = rng_range64(rng, LOWER[kind], UPPER[kind]);
+        in->odd[i] = rng_range64(rng, LOWER[kind], UPPER[kind]) | 1;
+
+        if (in->odd[i] < 5) in->odd[i] = 5;
+    }
+}
+
+/*****************************************************************************
+                                   BENCHMARKS
+ ****************************************************************************/
+
+/* Signed functions get inputs halved to stay within int64_t */
+
+static uint64_t bench_gcd(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += greatest_common_divisor(in->a[i] >> 1, in->b[i] >> 1);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_gcd_u64(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += gcd_u64(in->a[i], in->b[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_lcm(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += smallest_common_multiple(in->a[i] >> 1, in->b[i] >> 1);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_modpow_u64(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += modpow_u64(in->a[i], in->b[i], in->odd[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_is_prime(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += is_prime(in->odd[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_is_large_prime(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += is_large_prime(in->odd[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_passes_rabin_miller(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += passes_rabin_miller(in->odd[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_next_prime(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += next_prime(in->a[i]);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_next_prime_factor(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += next_prime_factor(in->a[i], 2);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_factorize_u64(const inputs *in, uint64_t param) {
+    uint64_t factors[FACTORIZE_MAX_FACTORS] = {0};
+    uint32_t exponents[FACTORIZE_MAX_FACTORS] = {0};
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += factorize_u64(in->a[i], factors, exponents);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Generator of kind param, kept across calls such that the state is warm
+ */
+static rng_state *bench_rng(uint64_t param) {
+    static rng_state rng = {0};
+    static bool ready = false;
+
+    if ((!ready) || (param != rng.kind)) {
+        rng_init_kind(&rng, (rng_kind)param, 1);
+        ready = true;
+    }
+
+    return &rng;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_rng_next64(const inputs *in, uint64_t param) {
+    rng_state *rng = bench_rng(param);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += rng_next64(rng);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_rng_fill_u64(const inputs *in, uint64_t param) {
+    uint64_t buf[BENCH_BATCH];
+
+    rng_fill_u64(bench_rng(param), buf, BENCH_BATCH);
+
+    return buf[0] + buf[BENCH_BATCH - 1];
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_rng_bounded64(const inputs *in, uint64_t param) {
+    rng_state *rng = bench_rng(param);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += rng_bounded64(rng, 1000000007);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_rng_normal(const inputs *in, uint64_t param) {
+    rng_state *rng = bench_rng(param);
+    double sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += rng_normal(rng);
+    }
+
+    return (uint64_t)sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint64_t bench_random_get32(const inputs *in, uint64_t param) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < BENCH_BATCH; ++i) {
+        sum += random_get32(0);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Trial division based ones are restricted to inputs below 2^32 */
+static const benchmark BENCHMARKS[] = {
+    {"greatest_common_divisor", bench_gcd, 0, INPUT_ALL},
+    {"gcd_u64", bench_gcd_u64, 0, INPUT_ALL},
+    {"smallest_common_multiple", bench_lcm, 0, INPUT_ALL},
+    {"modpow_u64", bench_modpow_u64, 0, INPUT_ALL},
+    {"is_prime", bench_is_prime, 0, INPUT_UP_TO_32},
+    {"is_large_prime", bench_is_large_prime, 0, INPUT_ALL},
+    {"passes_rabin_miller", bench_passes_rabin_miller, 0, INPUT_ALL},
+    {"next_prime", bench_next_prime, 0, INPUT_UP_TO_32},
+    {"next_prime_factor", bench_next_prime_factor, 0, INPUT_UP_TO_32},
+    {"factorize_u64", bench_factorize_u64, 0, INPUT_ALL},
+    {"random_get32", bench_random_get32, 0, 0},
+    {"rng_next64/lcg32", bench_rng_next64, RNG_LCG32, 0},
+    {"rng_next64/xoshiro256ss", bench_rng_next64, RNG_XOSHIRO256SS, 0},
+    {"rng_next64/pcg64", bench_rng_next64, RNG_PCG64, 0},
+    {"rng_next64/philox4x32", bench_rng_next64, RNG_PHILOX4X32, 0},
+    {"rng_fill_u64/xoshiro256ss", bench_rng_fill_u64, RNG_XOSHIRO256SS, 0},
+    {"rng_fill_u64/pcg64", bench_rng_fill_u64, RNG_PCG64, 0},
+    {"rng_fill_u64/philox4x32", bench_rng_fill_u64, RNG_PHILOX4X32, 0},
+    {"rng_bounded64/xoshiro256ss", bench_rng_bounded64, RNG_XOSHIRO256SS, 0},
+    {"rng_normal/xoshiro256ss", bench_rng_normal, RNG_XOSHIRO256SS, 0},
+};
+
+#define NUM_BENCHMARKS (sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]))
+
+/*****************************************************************************
+                                   MEASURING
+ ****************************************************************************/
+
+static int compare_doubles(const void *a, const void *b) {
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Nearest rank percentile of sorted samples
+ */
+static double percentile(const double *sorted, size_t count, double p) {
+    size_t rank = (size_t)(p / 100.0 * count + 0.5);
+
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+
+    return sorted[rank - 1];
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Returns the time of passes runs in ns
+ */
+static uint64_t time_passes(const benchmark *bench, const inputs *in,
+                            uint64_t passes) {
+    uint64_t sink = 0;
+    const uint64_t start = now_ns();
+
+    for (uint64_t pass = 0; pass < passes; ++pass) {
+        sink += bench->run(in, bench->param);
+    }
+
+    const uint64_t elapsed = now_ns() - start;
+
+    g_sink += sink;
+
+    return elapsed;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static bool run_benchmark(const benchmark *bench, const inputs *in,
+                          const char *input, size_t reps, size_t warmup,
+                          result *res) {
+    double *samples = calloc(reps, sizeof(double));
+
+    if (0 == samples) {
+        return false;
+    }
+
+    uint64_t passes = 1;
+
+    while ((time_passes(bench, in, passes) < BENCH_MIN_REP_NS) &&
+           (passes < (1ull << 32))) {
+        passes *= 2;
+    }
+
+    for (size_t i = 0; i < warmup; ++i) {
+        time_passes(bench, in, passes);
+    }
+
+    const uint64_t ops = passes * BENCH_BATCH;
+
+    for (size_t i = 0; i < reps; ++i) {
+        samples[i] = (double)time_passes(bench, in, passes) / ops;
+    }
+
+    qsort(samples, reps, sizeof(double), compare_doubles);
+
+    *res = (result){
+        .name = bench->name,
+        .input = input,
+        .reps = reps,
+        .ops_per_rep = ops,
+        .min = samples[0],
+        .p10 = percentile(samples, reps, 10),
+        .median = percentile(samples, reps, 50),
+        .p90 = percentile(samples, reps, 90),
+        .p99 = percentile(samples, reps, 99),
+        .max = samples[reps - 1],
+    };
+
+    free(samples);
+
+    return true;
+}
+
+/*****************************************************************************
+                                    OUTPUT
+ ****************************************************************************/
+
+static void print_header(format fmt) {
+    switch (fmt) {
+        case FORMAT_TEXT:
+            printf("%-28s %-7s %12s %14s %10s %10s %10s\n", "benchmark",
+                   "input", "ns/op", "ops/s", "p10", "p90", "p99");
+            break;
+
+        case FORMAT_CSV:
+            printf("name,input,reps,ops_per_rep,min_ns,p10_ns,median_ns,"
+                   "p90_ns,p99_ns,max_ns,ops_per_s\n");
+            break;
+
+        case FORMAT_JSON:
+            printf("[\n");
+            break;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void print_result(format fmt, const result *res, bool first) {
+    const double ops_per_s = 1e9 / res->median;
+
+    switch (fmt) {
+        case FORMAT_TEXT:
+            printf("%-28s %-7s %12.2f %14.0f %10.2f %10.2f %10.2f\n",
+                   res->name, res->input, res->median, ops_per_s, res->p10,
+                   res->p90, res->p99);
+            break;
+
+        case FORMAT_CSV:
+            printf("%s,%s,%zu,%" PRIu64 ",%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.0f\n",
+                   res->name, res->input, res->reps, res->ops_per_rep,
+                   res->min, res->p10, res->median, res->p90, res->p99,
+                   res->max, ops_per_s);
+            break;
+
+        case FORMAT_JSON:
+            printf("%s  {\"name\": \"%s\", \"input\": \"%s\", \"reps\": %zu, "
+                   "\"ops_per_rep\": %" PRIu64 ", \"min_ns\": %.3f, "
+                   "\"p10_ns\": %.3f, \"median_ns\": %.3f, \"p90_ns\": %.3f, "
+                   "\"p99_ns\": %.3f, \"max_ns\": %.3f, \"ops_per_s\": %.0f}",
+                   first ? "" : ",\n", res->name, res->input, res->reps,
+                   res->ops_per_rep, res->min, res->p10, res->median,
+                   res->p90, res->p99, res->max, ops_per_s);
+            break;
+    }
+
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void print_footer(format fmt) {
+    if (FORMAT_JSON == fmt) {
+        printf("\n]\n");
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-f text|csv|json] [-r REPS] [-w WARMUP] [FILTER]\n",
+            name);
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    format fmt = FORMAT_TEXT;
+    size_t reps = BENCH_DEFAULT_REPS;
+    size_t warmup = BENCH_DEFAULT_WARMUP;
+
+    int option = 0;
+
+    while (-1 != (option = getopt(argc, argv, "f:r:w:h"))) {
+        switch (option) {
+            case 'f':
+                if (0 == strcmp("text", optarg)) {
+                    fmt = FORMAT_TEXT;
+                } else if (0 == strcmp("csv", optarg)) {
+                    fmt = FORMAT_CSV;
+                } else if (0 == strcmp("json", optarg)) {
+                    fmt = FORMAT_JSON;
+                } else {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'r':
+                reps = strtoul(optarg, 0, 10);
+                break;
+
+            case 'w':
+                warmup = strtoul(optarg, 0, 10);
+                break;
+
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((0 == reps) || (optind + 1 < argc)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *filter = (optind < argc) ? argv[optind] : "";
+
+    /* Same inputs on every run, thus runs can be compared */
+    static inputs all_inputs[INPUT_KINDS];
+    rng_state rng = {0};
+    rng_init_kind(&rng, RNG_XOSHIRO256SS, 20200101);
+
+    for (size_t kind = 0; kind < INPUT_KINDS; ++kind) {
+        inputs_generate(all_inputs + kind, kind, &rng);
+    }
+
+    print_header(fmt);
+
+    bool first = true;
+
+    for (size_t i = 0; i < NUM_BENCHMARKS; ++i) {
+        const benchmark *bench = BENCHMARKS + i;
+
+        if (0 == strstr(bench->name, filter)) continue;
+
+        for (size_t kind = 0; kind < INPUT_KINDS; ++kind) {
+            const bool applies = (0 == bench->inputs)
+                                     ? (INPUT_NONE == kind)
+                                     : (0 != (bench->inputs & INPUT_BIT(kind)));
+
+            if (!applies) continue;
+
+            result res = {0};
+
+            if (!run_benchmark(bench, all_inputs + kind, INPUT_NAMES[kind],
+                               reps, warmup, &res)) {
+                fprintf(stderr, "Out of memory\n");
+                return EXIT_FAILURE;
+            }
+
+            print_result(fmt, &res, first);
+            first = false;
+        }
+    }
+
+    print_footer(fmt);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,419 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+#include "numerics_diff.h"
+
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NUMERICS_DIFF_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/*****************************************************************************
+                                   STENCILS
+ ****************************************************************************/
+
+typedef enum { SIMD_NONE = 0, SIMD_AVX2, SIMD_AVX512, SIMD_LEVELS } simd_level;
+
+/**
+ * Applies the centered stencil to in[begin, end), scaled by scale
+ */
+typedef void (*diff_uniform_kernel)(const double *restrict in,
+                                    double *restrict out, size_t begin,
+                                    size_t end, double scale);
+
+/**
+ * Applies the centered stencil for the points x to in[begin, end)
+ */
+typedef void (*diff_nonuniform_kernel)(const double *restrict x,
+                                       const double *restrict in,
+                                       double *restrict out, size_t begin,
+                                       size_t end);
+
+typedef void (*diff_weights_function)(double x0, const double *x, double *w);
+
+typedef struct {
+    unsigned order;
+    unsigned width;
+    /* width x width coefficients, row s for evaluating at x_s */
+    const double *coefficients;
+    diff_weights_function weights;
+    /* By simd_level */
+    diff_uniform_kernel uniform[SIMD_LEVELS];
+    diff_nonuniform_kernel nonuniform[SIMD_LEVELS];
+} diff_stencil;
+
+/* Generated, defines DIFF_STENCILS */
+#include "numerics_diff_kernels.h"
+
+#define DIFF_NUM_STENCILS (sizeof(DIFF_STENCILS) / sizeof(DIFF_STENCILS[0]))
+
+/*
+ * Each output sample depends on width neighbouring input samples only,
+ * thus a single pass streams through in and out, with all reuse within
+ * the L1 cache.
+ * Threads get contiguous ranges of whole blocks, which keeps them from
+ * sharing cache lines of out.
+ */
+
+/* 8 KiB of doubles, a multiple of any cache line */
+#define DIFF_BLOCK_SAMPLES 1024
+
+/* Fewer samples per thread than that are not worth a thread */
+#define DIFF_PARALLEL_MIN_SAMPLES (64 * DIFF_BLOCK_SAMPLES)
+
+static pthread_once_t g_diff_once = PTHREAD_ONCE_INIT;
+static simd_level g_diff_simd = SIMD_NONE;
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * As the kernels in numerics.c, honours NUMERICS_SIMD=none|avx2
+ */
+static void diff_init() {
+    simd_level level = SIMD_NONE;
+
+#ifdef NUMERICS_DIFF_X86_SIMD
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        level = SIMD_AVX2;
+    }
+
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512dq")) {
+        level = SIMD_AVX512;
+    }
+
+#endif
+
+    const char *requested = getenv("NUMERICS_SIMD");
+
+    if (0 == requested) {
+        g_diff_simd = level;
+    } else if (0 == strcmp(requested, "none")) {
+        g_diff_simd = SIMD_NONE;
+    } else if ((0 == strcmp(requested, "avx2")) && (SIMD_AVX2 < level)) {
+        g_diff_simd = SIMD_AVX2;
+    } else {
+        g_diff_simd = level;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static simd_level diff_simd_level() {
+    pthread_once(&g_diff_once, diff_init);
+    return g_diff_simd;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static const diff_stencil *diff_stencil_get(unsigned order, unsigned width) {
+    for (size_t i = 0; i < DIFF_NUM_STENCILS; ++i) {
+        if ((order == DIFF_STENCILS[i].order) &&
+            (width == DIFF_STENCILS[i].width)) {
+            return DIFF_STENCILS + i;
+        }
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_supported(unsigned order, unsigned width) {
+    return 0 != diff_stencil_get(order, width);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_coefficients_uniform(unsigned order, unsigned width, unsigned shift,
+                               double *coefficients) {
+    const diff_stencil *stencil = diff_stencil_get(order, width);
+
+    if ((0 == stencil) || (shift >= width) || (0 == coefficients)) {
+        return false;
+    }
+
+    for (unsigned j = 0; j < width; ++j) {
+        coefficients[j] = stencil->coefficients[shift * width + j];
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_weights(unsigned order, unsigned width, double x0, const double *x,
+                  double *weights) {
+    const diff_stencil *stencil = diff_stencil_get(order, width);
+
+    if ((0 == stencil) || (0 == x) || (0 == weights)) {
+        return false;
+    }
+
+    stencil->weights(x0, x, weights);
+
+    return true;
+}
+
+/*****************************************************************************
+                                   APPLYING
+ ****************************************************************************/
+
+typedef struct {
+    const diff_stencil *stencil;
+    simd_level simd;
+    /* 0 for uniform grids */
+    const double *x;
+    const double *in;
+    double *out;
+    double scale;
+    /* Range of interior samples */
+    size_t begin;
+    size_t end;
+} diff_task;
+
+/*----------------------------------------------------------------------------*/
+
+static void *diff_task_run(void *arg) {
+    const diff_task *task = arg;
+
+    if (0 == task->x) {
+        task->stencil->uniform[task->simd](task->in, task->out, task->begin,
+                                           task->end, task->scale);
+    } else {
+        task->stencil->nonuniform[task->simd](task->x, task->in, task->out,
+                                              task->begin, task->end);
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * One-sided stencils for the width / 2 samples at either edge
+ */
+static void diff_edges(const diff_stencil *stencil, const double *x,
+                       const double *in, double *out, size_t n,
+                       double scale) {
+    const size_t width = stencil->width;
+    const size_t half = width / 2;
+
+    double c[DIFF_MAX_WIDTH];
+
+    for (size_t i = 0; i < half; ++i) {
+        const size_t edges[2] = {i, n - 1 - i};
+        const size_t starts[2] = {0, n - width};
+
+        for (size_t e = 0; e < 2; ++e) {
+            const size_t k = edges[e];
+            const size_t start = starts[e];
+            const double *weights = c;
+
+            if (0 == x) {
+                weights = stencil->coefficients + (k - start) * width;
+            } else {
+                stencil->weights(x[k], x + start, c);
+            }
+
+            double sum = 0;
+
+            for (size_t j = 0; j < width; ++j) {
+                sum += weights[j] * in[start + j];
+            }
+
+            out[k] = scale * sum;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static size_t diff_threads(size_t num_threads, size_t num_samples) {
+    if (0 == num_threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (online > 0) ? (size_t)online : 1;
+    }
+
+    const size_t useful = num_samples / DIFF_PARALLEL_MIN_SAMPLES;
+
+    if (num_threads > useful) {
+        num_threads = useful;
+    }
+
+    return (0 < num_threads) ? num_threads : 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool diff_run(const diff_stencil *stencil, const double *x,
+                     const double *in, double *out, size_t n, double scale,
+                     size_t num_threads) {
+    const size_t half = stencil->width / 2;
+
+    diff_edges(stencil, x, in, out, n, (0 == x) ? scale : 1.0);
+
+    diff_task task = {
+        .stencil = stencil,
+        .simd = diff_simd_level(),
+        .x = x,
+        .in = in,
+        .out = out,
+        .scale = scale,
+        .begin = half,
+        .end = n - half,
+    };
+
+    num_threads = diff_threads(num_threads, task.end - task.begin);
+
+    if (1 == num_threads) {
+        diff_task_run(&task);
+        return true;
+    }
+
+    diff_task *tasks = calloc(num_threads, sizeof(diff_task));
+    pthread_t *threads = calloc(num_threads, sizeof(pthread_t));
+    bool *started = calloc(num_threads, sizeof(bool));
+
+    if ((0 == tasks) || (0 == threads) || (0 == started)) {
+        free(tasks);
+        free(threads);
+        free(started);
+        diff_task_run(&task);
+        return true;
+    }
+
+    /* Whole blocks per thread, counted from the start of out */
+    const size_t blocks = n / DIFF_BLOCK_SAMPLES + 1;
+    const size_t blocks_per_thread = (blocks + num_threads - 1) / num_threads;
+
+    size_t begin = task.begin;
+
+    for (size_t t = 0; t < num_threads; ++t) {
+        size_t end = (t + 1) * blocks_per_thread * DIFF_BLOCK_SAMPLES;
+
+        if ((end > task.end) || (t + 1 == num_threads)) {
+            end = task.end;
+        }
+
+        if (begin > end) {
+            begin = end;
+        }
+
+        tasks[t] = task;
+        tasks[t].begin = begin;
+        tasks[t].end = end;
+
+        begin = end;
+    }
+
+    /* The calling thread takes the first range, and any that could not be
+     * handed to a thread of its own */
+    for (size_t t = 1; t < num_threads; ++t) {
+        started[t] =
+            (0 == pthread_create(threads + t, 0, diff_task_run, tasks + t));
+    }
+
+    diff_task_run(tasks);
+
+    for (size_t t = 1; t < num_threads; ++t) {
+        if (started[t]) {
+            pthread_join(threads[t], 0);
+        } else {
+            diff_task_run(tasks + t);
+        }
+    }
+
+    free(tasks);
+    free(threads);
+    free(started);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_apply_uniform_parallel(unsigned order, unsigned width, double h,
+                                 const double *in, double *out, size_t n,
+                                 size_t num_threads) {
+    const diff_stencil *stencil = diff_stencil_get(order, width);
+
+    if ((0 == stencil) || (0 == in) || (0 == out) || (n < width)) {
+        return false;
+    }
+
+    return diff_run(stencil, 0, in, out, n, 1.0 / pow(h, order), num_threads);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_apply_uniform(unsigned order, unsigned width, double h,
+                        const double *in, double *out, size_t n) {
+    return diff_apply_uniform_parallel(order, width, h, in, out, n, 1);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_apply_parallel(unsigned order, unsigned width, const double *x,
+                         const double *in, double *out, size_t n,
+                         size_t num_threads) {
+    const diff_stencil *stencil = diff_stencil_get(order, width);
+
+    if ((0 == stencil) || (0 == x) || (0 == in) || (0 == out) ||
+        (n < width)) {
+        return false;
+    }
+
+    return diff_run(stencil, x, in, out, n, 1.0, num_threads);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool diff_apply(unsigned order, unsigned width, const double *x,
+                const double *in, double *out, size_t n) {
+    return diff_apply_parallel(order, width, x, in, out, n, 1);
+}
@@ -0,0 +1,126 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+#ifndef __NUMERICS_DIFF_H__
+#define __NUMERICS_DIFF_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*****************************************************************************
+                              Finite differences
+ ****************************************************************************/
+
+/*
+ * Stencils approximating the order-th derivative from width neighbouring
+ * samples, as derived by maxima/diff_quotientes.maxima.
+ *
+ * Supported are orders 1 .. 4 with odd widths order < width <= 9.
+ * A stencil of width w is exact for polynomials of degree < w.
+ *
+ * The stencils are generated by bin/diff_kernels_gen at build time and
+ * compiled in as constants.
+ */
+
+/**
+ * Returns whether there is a stencil for order and width
+ */
+bool diff_supported(unsigned order, unsigned width);
+
+/**
+ * Stores the width coefficients c_j of the stencil for the uniform grid
+ * x_j = j h, evaluated at x_shift, into coefficients:
+ *
+ *     f^(order)(x_shift) ~ sum_j c_j f(x_j) / h^order
+ *
+ * shift == width / 2 is the centered stencil, 0 and width - 1 are the
+ * one-sided ones.
+ * Returns false if there is no such stencil.
+ */
+bool diff_coefficients_uniform(unsigned order, unsigned width, unsigned shift,
+                               double *coefficients);
+
+/**
+ * Stores the width weights w_j for the distinct points x[0 .. width - 1]
+ * into weights:
+ *
+ *     f^(order)(x0) ~ sum_j w_j f(x[j])
+ *
+ * Returns false if there is no such stencil.
+ */
+bool diff_weights(unsigned order, unsigned width, double x0, const double *x,
+                  double *weights);
+
+/**
+ * Approximates the order-th derivative at each of the n samples in of a
+ * uniform grid with spacing h, into out.
+ * Uses the centered stencil, and one-sided ones within width / 2 of the
+ * edges.
+ * The interior is done by SIMD kernels if the CPU supports AVX2 or AVX-512,
+ * NUMERICS_SIMD=none|avx2 in the environment restricts them.
+ * Results are identical either way.
+ * in and out must not overlap.
+ * Returns false if there is no such stencil or n < width.
+ */
+bool diff_apply_uniform(unsigned order, unsigned width, double h,
+                        const double *in, double *out, size_t n);
+
+/**
+ * Like diff_apply_uniform, for samples in at the distinct, ascending points
+ * x
+ */
+bool diff_apply(unsigned order, unsigned width, const double *x,
+                const double *in, double *out, size_t n);
+
+/**
+ * Like diff_apply_uniform, but splits the samples among num_threads
+ * threads.
+ * num_threads == 0 uses one thread per online CPU.
+ * Uses fewer threads for arrays too small to be worth it.
+ */
+bool diff_apply_uniform_parallel(unsigned order, unsigned width, double h,
+                                 const double *in, double *out, size_t n,
+                                 size_t num_threads);
+
+/**
+ * Like diff_apply, but splits the samples among num_threads threads
+ */
+bool diff_apply_parallel(unsigned order, unsigned width, const double *x,
+                         const double *in, double *out, size_t n,
+                         size_t num_threads);
+
+#endif
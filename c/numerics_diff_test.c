@@ -0,0 +1,348 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+#include "numerics_diff.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+
+#define DIFF_TEST_SAMPLES 101
+#define DIFF_TEST_LARGE_SAMPLES (1 << 19)
+
+static const unsigned ORDERS_AND_WIDTHS[][2] = {
+    {1, 3}, {1, 5}, {1, 7}, {1, 9}, {2, 3}, {2, 5}, {2, 7}, {2, 9},
+    {3, 5}, {3, 7}, {3, 9}, {4, 5}, {4, 7}, {4, 9},
+};
+
+#define NUM_ORDERS_AND_WIDTHS \
+    (sizeof(ORDERS_AND_WIDTHS) / sizeof(ORDERS_AND_WIDTHS[0]))
+
+/*---------------------------------------------------------------------------*/
+
+static double factorial(unsigned n) {
+    return (n < 2) ? 1 : n * factorial(n - 1);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * p(x) = sum_k x^k / k! for k < degree, and its order-th derivative
+ */
+static double polynomial(unsigned degree, unsigned order, double x) {
+    double sum = 0;
+
+    for (unsigned k = order; k < degree; ++k) {
+        sum += pow(x, k - order) / factorial(k - order);
+    }
+
+    return sum;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_supported_test() {
+    assert(!diff_supported(0, 3));
+    assert(!diff_supported(1, 1));
+    assert(!diff_supported(1, 4));
+    assert(!diff_supported(3, 3));
+    assert(!diff_supported(5, 9));
+    assert(!diff_supported(1, 11));
+
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; ++i) {
+        assert(diff_supported(ORDERS_AND_WIDTHS[i][0], ORDERS_AND_WIDTHS[i][1]));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_coefficients_uniform_test() {
+    double c[9] = {0};
+
+    assert(!diff_coefficients_uniform(1, 3, 3, c));
+    assert(!diff_coefficients_uniform(1, 4, 0, c));
+
+    assert(diff_coefficients_uniform(1, 3, 1, c));
+    assert((-0.5 == c[0]) && (0 == c[1]) && (0.5 == c[2]));
+
+    assert(diff_coefficients_uniform(1, 3, 0, c));
+    assert((-1.5 == c[0]) && (2 == c[1]) && (-0.5 == c[2]));
+
+    assert(diff_coefficients_uniform(2, 3, 1, c));
+    assert((1 == c[0]) && (-2 == c[1]) && (1 == c[2]));
+
+    assert(diff_coefficients_uniform(4, 5, 2, c));
+    assert((1 == c[0]) && (-4 == c[1]) && (6 == c[2]) && (-4 == c[3]) &&
+           (1 == c[4]));
+
+    assert(diff_coefficients_uniform(1, 5, 2, c));
+    assert(fabs(1.0 / 12 - c[0]) < 1e-15);
+    assert(fabs(-2.0 / 3 - c[1]) < 1e-15);
+
+    /* sum_j c_j (j - shift)^k / k! = [k == order] for all k < width */
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; ++i) {
+        const unsigned order = ORDERS_AND_WIDTHS[i][0];
+        const unsigned width = ORDERS_AND_WIDTHS[i][1];
+
+        for (unsigned shift = 0; shift < width; ++shift) {
+            assert(diff_coefficients_uniform(order, width, shift, c));
+
+            for (unsigned k = 0; k < width; ++k) {
+                double moment = 0;
+
+                for (unsigned j = 0; j < width; ++j) {
+                    moment += c[j] * pow((double)j - shift, k) / factorial(k);
+                }
+
+                assert(fabs(((k == order) ? 1 : 0) - moment) < 1e-9);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_weights_test() {
+    double x[9] = {0};
+    double w[9] = {0};
+    double c[9] = {0};
+
+    assert(!diff_weights(1, 4, 0, x, w));
+
+    /* Reproduce the uniform coefficients on a scaled grid */
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; ++i) {
+        const unsigned order = ORDERS_AND_WIDTHS[i][0];
+        const unsigned width = ORDERS_AND_WIDTHS[i][1];
+        const double h = 0.25;
+
+        for (unsigned j = 0; j < width; ++j) {
+            x[j] = 3 + j * h;
+        }
+
+        for (unsigned shift = 0; shift < width; ++shift) {
+            assert(diff_weights(order, width, x[shift], x, w));
+            assert(diff_coefficients_uniform(order, width, shift, c));
+
+            for (unsigned j = 0; j < width; ++j) {
+                const double expected = c[j] / pow(h, order);
+                assert(fabs(expected - w[j]) <= 1e-9 * (1 + fabs(expected)));
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_apply_uniform_test() {
+    double in[DIFF_TEST_SAMPLES] = {0};
+    double out[DIFF_TEST_SAMPLES] = {0};
+
+    assert(!diff_apply_uniform(1, 4, 1, in, out, DIFF_TEST_SAMPLES));
+    assert(!diff_apply_uniform(1, 5, 1, in, out, 4));
+    assert(diff_apply_uniform(1, 5, 1, in, out, 5));
+
+    /* Exact for polynomials of degree < width, edges included */
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; ++i) {
+        const unsigned order = ORDERS_AND_WIDTHS[i][0];
+        const unsigned width = ORDERS_AND_WIDTHS[i][1];
+        const double h = 0.01;
+
+        for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+            in[k] = polynomial(width, 0, -0.5 + k * h);
+        }
+
+        assert(diff_apply_uniform(order, width, h, in, out,
+                                  DIFF_TEST_SAMPLES));
+
+        for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+            const double expected = polynomial(width, order, -0.5 + k * h);
+            assert(fabs(expected - out[k]) < 1e-4);
+        }
+    }
+
+    /* Accuracy improves with the width */
+    for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+        in[k] = sin(0.1 * k);
+    }
+
+    double error[2] = {0};
+
+    for (size_t i = 0; i < 2; ++i) {
+        assert(diff_apply_uniform(1, 3 + 4 * i, 0.1, in, out,
+                                  DIFF_TEST_SAMPLES));
+
+        for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+            error[i] = fmax(error[i], fabs(cos(0.1 * k) - out[k]));
+        }
+    }
+
+    assert(error[0] < 1e-2);
+    assert(error[1] < 1e-5);
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_apply_test() {
+    double x[DIFF_TEST_SAMPLES] = {0};
+    double in[DIFF_TEST_SAMPLES] = {0};
+    double out[DIFF_TEST_SAMPLES] = {0};
+
+    assert(!diff_apply(1, 4, x, in, out, DIFF_TEST_SAMPLES));
+
+    /* Irregular, but ascending grid */
+    for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+        x[k] = -0.5 + 0.01 * k + 0.003 * sin(7.0 * k);
+    }
+
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; ++i) {
+        const unsigned order = ORDERS_AND_WIDTHS[i][0];
+        const unsigned width = ORDERS_AND_WIDTHS[i][1];
+
+        for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+            in[k] = polynomial(width, 0, x[k]);
+        }
+
+        assert(diff_apply(order, width, x, in, out, DIFF_TEST_SAMPLES));
+
+        for (size_t k = 0; k < DIFF_TEST_SAMPLES; ++k) {
+            const double expected = polynomial(width, order, x[k]);
+            assert(fabs(expected - out[k]) < 1e-3);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int diff_apply_parallel_test() {
+    const size_t n = DIFF_TEST_LARGE_SAMPLES;
+
+    double *x = calloc(n, sizeof(double));
+    double *in = calloc(n, sizeof(double));
+    double *serial = calloc(n, sizeof(double));
+    double *parallel = calloc(n, sizeof(double));
+
+    assert((0 != x) && (0 != in) && (0 != serial) && (0 != parallel));
+
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = 1e-3 * k + 1e-4 * sin(k);
+        in[k] = sin(x[k]);
+    }
+
+    for (size_t i = 0; i < NUM_ORDERS_AND_WIDTHS; i += 3) {
+        const unsigned order = ORDERS_AND_WIDTHS[i][0];
+        const unsigned width = ORDERS_AND_WIDTHS[i][1];
+
+        /* Odd sizes for the kernels to leave a tail behind */
+        for (size_t size = n - 13; size <= n; size += 13) {
+            assert(diff_apply_uniform(order, width, 1e-3, in, serial, size));
+            assert(diff_apply_uniform_parallel(order, width, 1e-3, in,
+                                               parallel, size, 4));
+            assert(0 == memcmp(serial, parallel, size * sizeof(double)));
+
+            assert(diff_apply(order, width, x, in, serial, size));
+            assert(diff_apply_parallel(order, width, x, in, parallel, size, 0));
+            assert(0 == memcmp(serial, parallel, size * sizeof(double)));
+        }
+
+        /* The SIMD kernels agree with the plain stencil */
+        double c[9] = {0};
+        assert(diff_coefficients_uniform(order, width, width / 2, c));
+        assert(diff_apply_uniform(order, width, 1e-3, in, serial, n));
+
+        for (size_t k = width / 2; k < n - width / 2; k += 7) {
+            double expected = 0;
+
+            for (size_t j = 0; j < width; ++j) {
+                expected += c[j] * in[k - width / 2 + j];
+            }
+
+            expected /= pow(1e-3, order);
+
+            assert(fabs(expected - serial[k]) <=
+                   1e-9 * pow(1e3, order) * (1 + fabs(expected)));
+        }
+
+        double w[9] = {0};
+        assert(diff_apply(order, width, x, in, serial, n));
+
+        for (size_t k = width / 2; k < n - width / 2; k += 7) {
+            assert(diff_weights(order, width, x[k], x + k - width / 2, w));
+
+            double expected = 0;
+
+            for (size_t j = 0; j < width; ++j) {
+                expected += w[j] * in[k - width / 2 + j];
+            }
+
+            assert(expected == serial[k]);
+        }
+    }
+
+    free(x);
+    free(in);
+    free(serial);
+    free(parallel);
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    diff_supported_test();
+    diff_coefficients_uniform_test();
+    diff_weights_test();
+    diff_apply_uniform_test();
+    diff_apply_test();
+    diff_apply_parallel_test();
+
+    return EXIT_SUCCESS;
+}
@@ -38,8 +38,11 @@
 #include "numerics.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 /*---------------------------------------------------------------------------*/
 
@@ -62,6 +65,138 @@ static int greatest_common_divisor_test() {
     assert(2 * 97 == greatest_common_divisor(2 * 3 * 5 * 5 * 97, 2 * 97));
     assert(2 * 97 == greatest_common_divisor(2 * 3 * 5 * 5 * 97, 2 * 7 * 97));
 
+    assert(0 == greatest_common_divisor(0, 0));
+    assert(7 == greatest_common_divisor(0, 7));
+    assert(7 == greatest_common_divisor(-7, 0));
+    assert(6 == greatest_common_divisor(-12, 18));
+    assert(6 == greatest_common_divisor(12, -18));
+    assert(6 == greatest_common_divisor(-12, -18));
+    assert((1ull << 63) == greatest_common_divisor(INT64_MIN, 0));
+    assert((1ull << 62) == greatest_common_divisor(INT64_MIN, 1ll << 62));
+    assert(1 == greatest_common_divisor(INT64_MAX, INT64_MAX - 1));
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int gcd_u64_test() {
+    assert(0 == gcd_u64(0, 0));
+    assert(5 == gcd_u64(5, 0));
+    assert(5 == gcd_u64(0, 5));
+    assert(UINT64_MAX == gcd_u64(UINT64_MAX, UINT64_MAX));
+    assert(1 == gcd_u64(UINT64_MAX, UINT64_MAX - 1));
+    assert((1ull << 40) == gcd_u64(3ull << 40, 1ull << 63));
+    assert(4294967291ull == gcd_u64(4294967291ull * 4294967279ull,
+                                    4294967291ull * 3));
+
+    for (uint64_t n = 0; n < 300; ++n) {
+        for (uint64_t m = 0; m < 300; ++m) {
+            uint64_t expected = n;
+            uint64_t rest = m;
+
+            while (0 != rest) {
+                uint64_t t = expected % rest;
+                expected = rest;
+                rest = t;
+            }
+
+            assert(expected == gcd_u64(n, m));
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void check_extended_gcd(int64_t n, int64_t m) {
+    int64_t x = 0;
+    int64_t y = 0;
+
+    uint64_t g = extended_greatest_common_divisor(n, m, &x, &y);
+
+    assert(g == greatest_common_divisor(n, m));
+    assert((__int128)g == (__int128)n * x + (__int128)m * y);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int extended_greatest_common_divisor_test() {
+    int64_t x = 0;
+    int64_t y = 0;
+
+    assert(2 == extended_greatest_common_divisor(240, 46, &x, &y));
+    assert((-9 == x) && (47 == y));
+
+    assert(0 == extended_greatest_common_divisor(0, 0, 0, 0));
+
+    const int64_t values[] = {0,         1,         -1,        2,
+                              -3,        240,       46,        -46,
+                              1 << 30,   99991,     INT64_MAX, INT64_MIN,
+                              INT64_MAX - 1, INT64_MIN + 1, 4294967291ll * 3};
+
+    const size_t num_values = sizeof(values) / sizeof(values[0]);
+
+    for (size_t i = 0; i < num_values; ++i) {
+        for (size_t j = 0; j < num_values; ++j) {
+            check_extended_gcd(values[i], values[j]);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int batch_gcd_u64_test() {
+    uint64_t gcds[4000] = {0};
+
+    assert(batch_gcd_u64(gcds, 0, gcds));
+
+    const uint64_t single = 12;
+    assert(batch_gcd_u64(&single, 1, gcds));
+    assert(1 == gcds[0]);
+
+    const uint64_t zero[] = {3, 0, 5};
+    assert(!batch_gcd_u64(zero, 3, gcds));
+
+    const uint64_t small[] = {6, 35, 11, 1, 13 * 17, 17 * 2};
+    assert(batch_gcd_u64(small, 6, gcds));
+    assert((2 == gcds[0]) && (1 == gcds[1]) && (1 == gcds[2]) &&
+           (1 == gcds[3]) && (17 == gcds[4]) && (34 == gcds[5]));
+
+    /* Large enough for the multi precision division to use its fast path */
+    static uint64_t values[4000] = {0};
+    uint64_t state = 1;
+
+    for (size_t i = 0; i < 4000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values[i] = state | 1;
+    }
+
+    /* Plant some shared factors */
+    values[17] = 4294967291ull * 4294967279ull;
+    values[3999] = 4294967291ull * 4294967231ull;
+    values[2000] = 4294967279ull * 3;
+
+    assert(batch_gcd_u64(values, 4000, gcds));
+
+    for (size_t i = 0; i < 4000; ++i) {
+        uint64_t product_of_others = 1;
+
+        for (size_t j = 0; j < 4000; ++j) {
+            if (i == j) continue;
+            product_of_others = mulmod_u64(product_of_others, values[j],
+                                           values[i]);
+        }
+
+        assert(gcd_u64(values[i], product_of_others) == gcds[i]);
+    }
+
+    assert(4294967291ull * 4294967279ull == gcds[17]);
+    assert(4294967291ull == gcds[3999]);
+
     return EXIT_SUCCESS;
 }
 
@@ -79,6 +214,311 @@ static int smallest_common_multiple_test() {
     assert(2 * 3 * 5 * 5 * 7 * 13 * 11 ==
            smallest_common_multiple(2 * 3 * 5 * 5 * 7 * 13, 5 * 5 * 7 * 11));
 
+    assert(0 == smallest_common_multiple(0, 5));
+    assert(0 == smallest_common_multiple(5, 0));
+    assert(6 == smallest_common_multiple(-2, 3));
+    assert(6 == smallest_common_multiple(-2, -3));
+
+    /* n * m overflows, the result does not */
+    assert((1ull << 62) == smallest_common_multiple(1ll << 62, 1ll << 61));
+    assert(4294967291ull * 4294967279ull ==
+           smallest_common_multiple(4294967291ll, -4294967279ll));
+
+    /* The result overflows */
+    assert(0 == smallest_common_multiple(INT64_MAX, INT64_MAX - 1));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int modinv_u64_test() {
+    assert(0 == modinv_u64(3, 0));
+    assert(0 == modinv_u64(3, 1));
+    assert(1 == modinv_u64(1, 2));
+    assert(4 == modinv_u64(3, 11));
+    assert(4 == modinv_u64(3 + 11 * 5, 11));
+    assert(10 == modinv_u64(10, 11));
+    assert(0 == modinv_u64(0, 11));
+    assert(0 == modinv_u64(22, 11));
+    assert(0 == modinv_u64(6, 9));
+    assert(7 == modinv_u64(7, 12));
+
+    /* Bezout coefficients exceed 63 bits */
+    const uint64_t p = UINT64_MAX - 58;
+    assert(UINT64_MAX - 59 == modinv_u64(p - 1, p));
+    assert(1 == mulmod_u64(modinv_u64(1234567890123ull, p), 1234567890123ull,
+                           p));
+    assert(1 == mulmod_u64(modinv_u64(p - 2, p), p - 2, p));
+
+    assert(1 == mulmod_u64(modinv_u64(3, UINT64_MAX - 1), 3, UINT64_MAX - 1));
+    assert(0 == modinv_u64(2, UINT64_MAX - 1));
+
+    for (uint64_t n = 2; n < 200; ++n) {
+        for (uint64_t a = 0; a < 2 * n; ++a) {
+            uint64_t inv = modinv_u64(a, n);
+
+            if (1 == gcd_u64(a, n)) {
+                assert((0 < inv) && (inv < n));
+                assert(1 == a * inv % n);
+            } else {
+                assert(0 == inv);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void check_modinv_batch_u64(const uint64_t *values, size_t count,
+                                   uint64_t n) {
+    uint64_t *inverses = calloc(count + 1, sizeof(uint64_t));
+    uint64_t *in_place = calloc(count + 1, sizeof(uint64_t));
+    assert((0 != inverses) && (0 != in_place));
+
+    bool invertible = true;
+
+    for (size_t i = 0; i < count; ++i) {
+        invertible = invertible && (0 != modinv_u64(values[i], n));
+    }
+
+    assert(invertible == modinv_batch_u64(values, inverses, count, n));
+
+    memcpy(in_place, values, count * sizeof(uint64_t));
+    assert(invertible == modinv_batch_u64(in_place, in_place, count, n));
+
+    for (size_t i = 0; i < count; ++i) {
+        assert(modinv_u64(values[i], n) == inverses[i]);
+        assert(inverses[i] == in_place[i]);
+    }
+
+    free(inverses);
+    free(in_place);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int modinv_batch_u64_test() {
+    uint64_t dummy = 3;
+    assert(!modinv_batch_u64(&dummy, &dummy, 1, 1));
+    assert(modinv_batch_u64(0, 0, 0, 11));
+
+    uint64_t values[1000] = {0};
+    rng_state rng = {0};
+    rng_init(&rng);
+
+    const uint64_t moduli[] = {2,
+                               3,
+                               1000003,
+                               1ull << 40,
+                               4294967291ull * 4294967279ull,
+                               UINT64_MAX - 58,
+                               UINT64_MAX - 1,
+                               UINT64_MAX};
+
+    for (size_t m = 0; m < sizeof(moduli) / sizeof(moduli[0]); ++m) {
+        const uint64_t n = moduli[m];
+
+        for (size_t i = 0; i < 1000; ++i) {
+            do {
+                values[i] = rng_next64(&rng);
+            } while (1 != gcd_u64(values[i], n));
+        }
+
+        check_modinv_batch_u64(values, 1, n);
+        check_modinv_batch_u64(values, 2, n);
+        check_modinv_batch_u64(values, 1000, n);
+
+        /* Not invertible: The others are inverted nevertheless */
+        values[500] = 0;
+        check_modinv_batch_u64(values, 1000, n);
+
+        values[0] = n;
+        check_modinv_batch_u64(values, 1, n);
+    }
+
+    values[7] = 6;
+    check_modinv_batch_u64(values, 10, 9);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int crt_u64_test() {
+    uint64_t x = 1;
+    uint64_t m = 0;
+
+    assert(crt_u64(0, 0, 0, &x, &m));
+    assert((0 == x) && (1 == m));
+
+    const uint64_t r1[] = {2, 3, 2};
+    const uint64_t m1[] = {3, 5, 7};
+    assert(crt_u64(r1, m1, 3, &x, &m));
+    assert((23 == x) && (105 == m));
+
+    /* Residues need not be reduced */
+    const uint64_t r2[] = {2 + 3 * 100, 3 + 5, 2 + 7 * 1000};
+    assert(crt_u64(r2, m1, 3, &x, 0));
+    assert(23 == x);
+
+    /* Not coprime, but consistent */
+    const uint64_t r3[] = {2, 4};
+    const uint64_t m3[] = {4, 6};
+    assert(crt_u64(r3, m3, 2, &x, &m));
+    assert((10 == x) && (12 == m));
+
+    const uint64_t r4[] = {5, 5, 5};
+    const uint64_t m4[] = {12, 6, 4};
+    assert(crt_u64(r4, m4, 3, &x, &m));
+    assert((5 == x) && (12 == m));
+
+    /* Inconsistent */
+    const uint64_t r5[] = {1, 2};
+    assert(!crt_u64(r5, m3, 2, &x, &m));
+
+    const uint64_t m5[] = {3, 0};
+    assert(!crt_u64(r5, m5, 2, &x, &m));
+
+    /* Intermediates beyond 64 bits */
+    const uint64_t p = 4294967291ull;
+    const uint64_t q = 4294967279ull;
+    const uint64_t r6[] = {p - 1, q - 2};
+    const uint64_t m6[] = {p, q};
+    assert(crt_u64(r6, m6, 2, &x, &m));
+    assert(p * q == m);
+    assert((p - 1 == x % p) && (q - 2 == x % q));
+
+    const uint64_t r7[] = {UINT64_MAX - 100, 12345};
+    const uint64_t m7[] = {UINT64_MAX, 1};
+    assert(crt_u64(r7, m7, 2, &x, &m));
+    assert((UINT64_MAX - 100 == x) && (UINT64_MAX == m));
+
+    /* lcm overflows */
+    const uint64_t m8[] = {p, q, 5};
+    const uint64_t r8[] = {0, 0, 0};
+    assert(!crt_u64(r8, m8, 3, &x, &m));
+
+    const uint64_t m9[] = {UINT64_MAX, 2};
+    assert(!crt_u64(r8, m9, 2, &x, &m));
+
+    /* Against brute force */
+    for (uint64_t a = 1; a < 30; ++a) {
+        for (uint64_t b = 1; b < 30; ++b) {
+            for (uint64_t ra = 0; ra < a; ++ra) {
+                for (uint64_t rb = 0; rb < b; ++rb) {
+                    const uint64_t r[] = {ra, rb};
+                    const uint64_t mod[] = {a, b};
+
+                    uint64_t expected = UINT64_MAX;
+                    const uint64_t lcm = smallest_common_multiple(a, b);
+
+                    for (uint64_t y = 0; y < lcm; ++y) {
+                        if ((ra == y % a) && (rb == y % b)) {
+                            expected = y;
+                            break;
+                        }
+                    }
+
+                    if (UINT64_MAX == expected) {
+                        assert(!crt_u64(r, mod, 2, &x, &m));
+                    } else {
+                        assert(crt_u64(r, mod, 2, &x, &m));
+                        assert((expected == x) && (lcm == m));
+                    }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int mulmod_u64_test() {
+    assert(0 == mulmod_u64(3, 4, 12));
+    assert(2 == mulmod_u64(3, 4, 10));
+    assert(0 == mulmod_u64(UINT64_MAX, UINT64_MAX, UINT64_MAX));
+    assert(1 == mulmod_u64(UINT64_MAX - 1, UINT64_MAX - 1, UINT64_MAX));
+
+    /* (2^64 - 1)^2 = 2^128 - 2^65 + 1 */
+    assert(1 == mulmod_u64(UINT64_MAX, UINT64_MAX, 1ull << 63));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int modpow_u64_test() {
+    assert(1 == modpow_u64(7, 0, 13));
+    assert(0 == modpow_u64(7, 0, 1));
+    assert(0 == modpow_u64(7, 5, 1));
+    assert(3 == modpow_u64(3, 1, 7));
+    assert(1 == modpow_u64(3, 6, 7));
+    assert(24 == modpow_u64(2, 10, 1000));
+    assert(445 == modpow_u64(4, 13, 497));
+
+    for (uint64_t a = 0; a < 20; ++a) {
+        uint64_t expected = 1;
+
+        for (uint64_t d = 0; d < 40; ++d) {
+            assert(expected == modpow_u64(a, d, 1009));
+            expected = (expected * a) % 1009;
+        }
+    }
+
+    /* Fermat: 2^(p-1) = 1 mod p for the largest prime below 2^64 */
+    const uint64_t p = 18446744073709551557ull;
+    assert(1 == modpow_u64(2, p - 1, p));
+    assert(1 == modpow_u64(UINT64_MAX, p - 1, p));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int montgomery_test() {
+    montgomery_ctx ctx = {0};
+
+    assert(!montgomery_init(&ctx, 0));
+    assert(!montgomery_init(&ctx, 1));
+    assert(!montgomery_init(&ctx, 1024));
+
+    const uint64_t moduli[] = {3, 1009, 4294967291ull, 4294967297ull,
+                               1000000000000000003ull, UINT64_MAX,
+                               18446744073709551557ull};
+
+    for (size_t i = 0; i < sizeof(moduli) / sizeof(moduli[0]); ++i) {
+        const uint64_t n = moduli[i];
+        assert(montgomery_init(&ctx, n));
+
+        for (uint64_t a = n - 100; a != n + 100; ++a) {
+            uint64_t b = a * 0x9e3779b97f4a7c15ull;
+
+            uint64_t am = montgomery_to(&ctx, a);
+            uint64_t bm = montgomery_to(&ctx, b);
+
+            assert(a % n == montgomery_from(&ctx, am));
+            assert(mulmod_u64(a, b, n) ==
+                   montgomery_from(&ctx, montgomery_mul(&ctx, am, bm)));
+            assert(mulmod_u64(a, a, n) ==
+                   montgomery_from(&ctx, montgomery_square(&ctx, am)));
+            assert(montgomery_mul(&ctx, am, bm) < n);
+        }
+
+        assert(ctx.one == montgomery_to(&ctx, 1));
+        assert(1 == montgomery_from(&ctx, montgomery_pow(&ctx, ctx.one, 77)));
+    }
+
+    assert(montgomery_init(&ctx, 1009));
+    assert(1 == montgomery_from(
+                    &ctx, montgomery_pow(&ctx, montgomery_to(&ctx, 11), 1008)));
+    assert(0 == montgomery_from(
+                    &ctx, montgomery_pow(&ctx, montgomery_to(&ctx, 2018), 3)));
+
     return EXIT_SUCCESS;
 }
 
@@ -120,6 +560,17 @@ static int is_prime_test() {
     assert(!is_prime(7919 - 1));
     assert(!is_prime(7919 + 1));
 
+    /* Every spoke of the wheel, and squares right at the square root */
+    for (uint64_t n = 0; n < 100000; ++n) {
+        assert(is_prime_u64(n) == is_prime(n));
+    }
+
+    assert(!is_prime(7 * 7));
+    assert(!is_prime(31 * 31));
+    assert(!is_prime(65521ull * 65521));
+    assert(!is_prime(1000003ull * 1000003));
+    assert(is_prime(4294967291ull));
+
     return EXIT_SUCCESS;
 }
 
@@ -160,6 +611,42 @@ static int is_large_prime_test() {
 
 /*----------------------------------------------------------------------------*/
 
+static int is_prime_u64_test() {
+    assert(!is_prime_u64(0));
+    assert(!is_prime_u64(1));
+    assert(is_prime_u64(2));
+    assert(is_prime_u64(3));
+
+    for (uint64_t n = 0; n < 100000; ++n) {
+        assert(is_prime(n) == is_prime_u64(n));
+    }
+
+    // Carmichael numbers
+    assert(!is_prime_u64(561));
+    assert(!is_prime_u64(1105));
+    assert(!is_prime_u64(41041));
+
+    // Strong pseudoprimes to several small prime bases
+    assert(!is_prime_u64(3215031751ull));
+    assert(!is_prime_u64(2152302898747ull));
+    assert(!is_prime_u64(3474749660383ull));
+    assert(!is_prime_u64(341550071728321ull));
+    assert(!is_prime_u64(3825123056546413051ull));
+
+    assert(is_prime_u64(4294967291ull));
+    assert(!is_prime_u64(4294967295ull));
+    assert(is_prime_u64(4294967311ull));
+    assert(!is_prime_u64(4294967291ull * 4294967279ull));
+    assert(is_prime_u64(1000000000000000003ull));
+    assert(is_prime_u64(18446744073709551557ull));
+    assert(!is_prime_u64(18446744073709551559ull));
+    assert(!is_prime_u64(UINT64_MAX));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
 static int passes_rabin_miller_test() {
 
     for(uint64_t i = 3; i < 100000; ++i) {
@@ -204,41 +691,1365 @@ static int next_prime_factor_test() {
     return EXIT_SUCCESS;
 }
 
-/*---------------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
 
-static int random_range_test() {
-    long r = random_range(10, 20);
-    assert((10 <= r) && (20 >= r));
+/**
+ * Checks that the factorization of n is complete and consistent
+ */
+static void check_factorization(uint64_t n) {
+    uint64_t factors[FACTORIZE_MAX_FACTORS] = {0};
+    uint32_t exponents[FACTORIZE_MAX_FACTORS] = {0};
 
-    r = random_range(0, 32000);
-    assert((0 <= r) && (32000 >= r));
+    size_t num_factors = factorize_u64(n, factors, exponents);
 
-    // random_range(0, 0) will give rands between 0 and RAND_MAX, since
-    // random_range(*, 0) indicates 'all possible values'
-    for (long i = 1; i < RAND_MAX; ++i) {
-        r = random_range(0, i);
-        assert((0 <= r) && (i >= r));
+    uint64_t product = 1;
+
+    for (size_t i = 0; i < num_factors; ++i) {
+        assert(is_prime_u64(factors[i]));
+        assert(0 < exponents[i]);
+        assert((0 == i) || (factors[i - 1] < factors[i]));
+
+        for (uint32_t e = 0; e < exponents[i]; ++e) {
+            product *= factors[i];
+        }
     }
 
-    long max = 21191;
+    assert(product == n);
+}
 
-    for (long i = 0; i < max; ++i) {
-        r = random_range(i, max);
-        assert((i <= r) && (max >= r));
+/*----------------------------------------------------------------------------*/
+
+static int factorize_u64_test() {
+    uint64_t factors[FACTORIZE_MAX_FACTORS] = {0};
+    uint32_t exponents[FACTORIZE_MAX_FACTORS] = {0};
+
+    assert(0 == factorize_u64(0, factors, exponents));
+    assert(0 == factorize_u64(1, factors, exponents));
+
+    assert(1 == factorize_u64(2, factors, exponents));
+    assert((2 == factors[0]) && (1 == exponents[0]));
+
+    assert(1 == factorize_u64(1ull << 63, factors, exponents));
+    assert((2 == factors[0]) && (63 == exponents[0]));
+
+    assert(3 == factorize_u64(101 * 239 * 757, factors, exponents));
+    assert((101 == factors[0]) && (239 == factors[1]) && (757 == factors[2]));
+
+    /* 2^64 - 1 = 3 * 5 * 17 * 257 * 641 * 65537 * 6700417 */
+    assert(7 == factorize_u64(UINT64_MAX, factors, exponents));
+    assert((641 == factors[4]) && (6700417 == factors[6]));
+
+    /* Semiprime of two 32 bit primes */
+    assert(2 == factorize_u64(4294967291ull * 4294967279ull, factors,
+                              exponents));
+    assert((4294967279ull == factors[0]) && (4294967291ull == factors[1]));
+
+    /* Prime square */
+    assert(1 == factorize_u64(4294967291ull * 4294967291ull, factors,
+                              exponents));
+    assert((4294967291ull == factors[0]) && (2 == exponents[0]));
+
+    /* Product of the first 15 primes has the most distinct factors */
+    assert(15 == factorize_u64(614889782588491410ull, factors, exponents));
+    assert(47 == factors[14]);
+
+    assert(1 == factorize_u64(18446744073709551557ull, factors, exponents));
+
+    for (uint64_t n = 2; n < 100000; ++n) {
+        check_factorization(n);
     }
 
-    for (long i = max; i < 2 * max; ++i) {
-        long r = random_range(i, 2 * max);
+    for (uint64_t n = UINT64_MAX - 1000; n < UINT64_MAX; ++n) {
+        check_factorization(n);
+    }
 
-        assert(r <= 2 * max);
-        assert(r >= i);
+    check_factorization(1000000016000000063ull);
+    check_factorization(3825123056546413051ull);
+    check_factorization(59ull * 59 * 61 * 61 * 67 * 67 * 71 * 71);
+
+    /* Around the trial division limit */
+    check_factorization(1021ull * 1031);
+    check_factorization(1031ull * 1031 * 1031);
+    check_factorization(1021ull * 1021 * 4294967291ull);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool count_and_check_prime(uint64_t prime, void *ctx) {
+    uint64_t *last = ctx;
+
+    assert(is_prime(prime));
+    assert(prime == next_prime(*last));
+
+    *last = prime;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int prime_table_test() {
+    assert(0 == prime_table_limit());
+    assert(!prime_table_is_prime(7));
+    assert(0 == prime_table_next(7));
+    assert(0 == prime_table_nth(1));
+
+    assert(prime_table_init(4));
+    assert(prime_table_is_prime(3));
+    assert(!prime_table_is_prime(5));
+    assert(3 == prime_table_next(2));
+    assert(0 == prime_table_next(3));
+
+    const uint64_t limit = 1000003;
+    assert(prime_table_init(limit));
+    assert(limit == prime_table_limit());
+
+    uint64_t nth = 0;
+
+    for (uint64_t n = 0; n <= limit; ++n) {
+        bool prime = is_prime_u64(n);
+        assert(prime == prime_table_is_prime(n));
+
+        if (prime) {
+            assert(n == prime_table_nth(++nth));
+        }
     }
 
-    long min = RAND_MAX - 1;
-    max = RAND_MAX;
+    /* 78498 primes below 10^6, 1000003 is prime */
+    assert(78499 == nth);
+    assert(limit == prime_table_nth(78499));
+    assert(0 == prime_table_nth(78500));
+    assert(0 == prime_table_next(limit));
 
-    r = random_range(min, max);
-    assert((min <= r) && (max >= r));
+    assert(2 == prime_table_next(0));
+    assert(11 == prime_table_next(7));
+    assert(101 == prime_table_next(100));
+    assert(211 == prime_table_next(200));
+    assert(limit == prime_table_next(999983));
+
+    uint64_t last = 0;
+    assert(78499 == prime_table_foreach(0, UINT64_MAX, count_and_check_prime,
+                                        &last));
+    assert(limit == last);
+
+    last = 99;
+    assert(21 == prime_table_foreach(100, 200, count_and_check_prime, &last));
+
+    /* The table is consulted transparently */
+    assert(!is_prime(1));
+    assert(is_prime(7919));
+    assert(!is_prime(7919 * 11));
+    assert(7927 == next_prime(7919));
+    assert(1000033 == next_prime(limit));
+
+    uint64_t number = 101 * 239 * 757;
+    assert(101 == next_prime_factor(number, 2));
+    assert(239 == next_prime_factor(number, 102));
+    assert(757 == next_prime_factor(number, 240));
+
+    /* Stored and mapped again */
+    char path[] = "/tmp/numerics_test_XXXXXX";
+    int fd = mkstemp(path);
+    assert(0 <= fd);
+    close(fd);
+
+    assert(prime_table_save(path));
+    prime_table_free();
+    assert(!prime_table_save(path));
+
+    assert(prime_table_load(path));
+    assert(limit == prime_table_limit());
+    assert(limit == prime_table_nth(78499));
+    assert(prime_table_is_prime(999983));
+    assert(!prime_table_is_prime(999985));
+    assert(101 == prime_table_next(100));
+
+    last = 0;
+    assert(78499 == prime_table_foreach(0, UINT64_MAX, count_and_check_prime,
+                                        &last));
+
+    /* Corrupt files are rejected, the current table stays.
+     * The file at path is mapped right now, thus corrupt a copy of it */
+    char copy[] = "/tmp/numerics_test_XXXXXX";
+    fd = mkstemp(copy);
+    assert(0 <= fd);
+    close(fd);
+
+    assert(prime_table_save(copy));
+
+    FILE *file = fopen(copy, "r+b");
+    assert(0 != file);
+    assert(0 == fseek(file, 8, SEEK_SET));
+    assert(1 == fwrite("\xff", 1, 1, file));
+    assert(0 == fclose(file));
+
+    assert(!prime_table_load(copy));
+    assert(limit == prime_table_limit());
+    assert(prime_table_is_prime(999983));
+
+    assert(0 == truncate(copy, 100));
+    assert(!prime_table_load(copy));
+
+    last = 0;
+    assert(78499 == prime_table_foreach(0, UINT64_MAX, count_and_check_prime,
+                                        &last));
+
+    assert(0 == remove(copy));
+    assert(0 == remove(path));
+    assert(!prime_table_load(path));
+
+    assert(limit == prime_table_limit());
+    prime_table_free();
+    assert(0 == prime_table_limit());
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool count_prime(uint64_t prime, void *ctx) {
+    uint64_t *count = ctx;
+    ++*count;
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int prime_range_test() {
+    uint64_t last = 0;
+    uint64_t count = 0;
+
+    assert(0 == prime_range_foreach(10, 10, count_prime, &count));
+    assert(0 == prime_range_foreach(24, 29, count_prime, &count));
+    assert(0 == count);
+
+    assert(78498 == prime_range_foreach(0, 1000000, count_and_check_prime,
+                                        &last));
+    assert(999983 == last);
+
+    /* Crosses several segments */
+    assert(664579 == prime_range_foreach(0, 10000000, count_prime, &count));
+
+    last = 1000000000;
+    assert(49 ==
+           prime_range_foreach(1000000000, 1000001000, count_and_check_prime,
+                               &last));
+
+    uint64_t primes[10] = {0};
+
+    assert(4 == prime_range_fill(0, 10, primes, 10));
+    assert((2 == primes[0]) && (3 == primes[1]) && (5 == primes[2]) &&
+           (7 == primes[3]));
+
+    assert(3 == prime_range_fill(100, 1000, primes, 3));
+    assert((101 == primes[0]) && (103 == primes[1]) && (107 == primes[2]));
+
+    /* The 10 largest primes below 2^64 */
+    const uint64_t largest[] = {
+        18446744073709551557ull, 18446744073709551533ull,
+        18446744073709551521ull, 18446744073709551437ull,
+        18446744073709551427ull, 18446744073709551359ull,
+        18446744073709551337ull, 18446744073709551293ull,
+        18446744073709551263ull, 18446744073709551253ull};
+
+    assert(10 == prime_range_fill(18446744073709551253ull, UINT64_MAX, primes,
+                                  10));
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(largest[9 - i] == primes[i]);
+    }
+
+    /* Narrow windows are sieved in one go, wide ones segment by segment */
+    const uint64_t windows[][2] = {
+        {(1ull << 52) - 100000, (1ull << 52) + 100000},
+        {10000000000ull, 10000000000ull + 4000000},
+    };
+
+    for (size_t i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i) {
+        count = 0;
+        prime_range_foreach(windows[i][0], windows[i][1], count_prime, &count);
+
+        uint64_t expected = 0;
+
+        for (uint64_t n = windows[i][0]; n < windows[i][1]; ++n) {
+            if (is_prime_u64(n)) ++expected;
+        }
+
+        assert(expected == count);
+    }
+
+    /* Must give identical results with the prime table in place */
+    assert(prime_table_init(100000));
+    last = 0;
+    assert(78498 == prime_range_foreach(0, 1000000, count_and_check_prime,
+                                        &last));
+    assert(4 == prime_range_fill(0, 10, primes, 10));
+    prime_table_free();
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+typedef struct {
+    uint64_t last;
+    uint64_t count;
+    uint64_t stop_after;
+} ascending_check;
+
+static bool check_ascending(uint64_t prime, void *ctx) {
+    ascending_check *check = ctx;
+
+    assert(check->last < prime);
+
+    check->last = prime;
+    ++check->count;
+
+    return check->count != check->stop_after;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int prime_range_parallel_test() {
+    prime_range_totals totals = {0};
+
+    assert(prime_range_totals_parallel(0, 2000000, 4, &totals));
+    assert(148933 == totals.count);
+    assert(0 == totals.sum_high);
+    assert(142913828922ull == totals.sum_low);
+
+    const uint64_t lo = 1000;
+    const uint64_t hi = 30000000;
+
+    prime_range_totals sequential = {0};
+    assert(prime_range_totals_parallel(lo, hi, 1, &sequential));
+    assert(prime_range_totals_parallel(lo, hi, 4, &totals));
+
+    assert(sequential.count == totals.count);
+    assert(sequential.sum_low == totals.sum_low);
+    assert(sequential.sum_high == totals.sum_high);
+
+    ascending_check check = {0};
+
+    assert(sequential.count ==
+           prime_range_foreach_parallel(lo, hi, 3, check_ascending, &check));
+    assert(sequential.count == check.count);
+    assert(29999999 == check.last);
+
+    /* Stop in the middle of the window */
+    check = (ascending_check){.stop_after = 1000000};
+    assert(1000000 ==
+           prime_range_foreach_parallel(lo, hi, 3, check_ascending, &check));
+    assert(1000000 == check.count);
+
+#ifdef NUMERICS_FAULT_INJECTION
+    /* Failing chunks are made up for sequentially, also the very first */
+    for (uint64_t chunk = 0; chunk < 3; chunk += 2) {
+        numerics_fault_parallel_sieve(chunk);
+
+        check = (ascending_check){0};
+        assert(sequential.count ==
+               prime_range_foreach_parallel(lo, hi, 3, check_ascending,
+                                            &check));
+        assert(sequential.count == check.count);
+        assert(29999999 == check.last);
+    }
+
+    numerics_fault_parallel_sieve(UINT64_MAX);
+#endif
+
+    /* Sums beyond 64 bits */
+    assert(prime_range_totals_parallel(UINT64_MAX - 1000, UINT64_MAX, 2,
+                                       &totals));
+    assert(1 < totals.count);
+    assert(totals.count - 1 == totals.sum_high);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define ARRAY_TEST_COUNT 1001
+
+static uint64_t array_test_next(uint64_t *state) {
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    return *state;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Walks from start in both directions, comparing against is_prime_u64
+ */
+static void check_prime_iterator(uint64_t start, size_t steps) {
+    prime_iterator it = {0};
+    assert(prime_iterator_init(&it, start));
+
+    uint64_t expected = start;
+
+    for (size_t i = 0; i < steps; ++i) {
+        while (!is_prime_u64(expected)) ++expected;
+
+        assert(expected == prime_iterator_next(&it));
+        ++expected;
+    }
+
+    prime_iterator_skip_to(&it, start);
+    expected = start;
+
+    for (size_t i = 0; (i < steps) && (2 <= expected); ++i) {
+        while (!is_prime_u64(expected)) --expected;
+
+        assert(expected == prime_iterator_prev(&it));
+        --expected;
+    }
+
+    prime_iterator_free(&it);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int prime_iterator_test() {
+    prime_iterator it = {0};
+
+    assert(prime_iterator_init(&it, 0));
+    assert(0 == prime_iterator_prev(&it));
+    assert(2 == prime_iterator_next(&it));
+    assert(3 == prime_iterator_next(&it));
+    assert(5 == prime_iterator_next(&it));
+    assert(3 == prime_iterator_prev(&it));
+    assert(2 == prime_iterator_prev(&it));
+    assert(0 == prime_iterator_prev(&it));
+    /* The end, not a failure */
+    assert(!prime_iterator_failed(&it));
+
+    /* Same count as the segmented sieve, across many window slides */
+    prime_iterator_skip_to(&it, 0);
+    uint64_t count = 0;
+
+    while (prime_iterator_next(&it) < 10000000) ++count;
+    assert(664579 == count);
+
+    prime_iterator_skip_to(&it, 10000000);
+    count = 0;
+
+    while (0 != prime_iterator_prev(&it)) ++count;
+    assert(664579 == count);
+
+    /* Inclusive start */
+    prime_iterator_skip_to(&it, 999983);
+    assert(999983 == prime_iterator_next(&it));
+    prime_iterator_skip_to(&it, 999983);
+    assert(999983 == prime_iterator_prev(&it));
+
+    /* The largest primes below 2^64 and beyond */
+    prime_iterator_skip_to(&it, 18446744073709551253ull);
+    assert(18446744073709551253ull == prime_iterator_next(&it));
+    assert(18446744073709551263ull == prime_iterator_next(&it));
+    prime_iterator_skip_to(&it, 18446744073709551558ull);
+    assert(0 == prime_iterator_next(&it));
+    assert(!prime_iterator_failed(&it));
+    assert(18446744073709551557ull == prime_iterator_prev(&it));
+    prime_iterator_skip_to(&it, UINT64_MAX);
+    assert(18446744073709551557ull == prime_iterator_prev(&it));
+    assert(18446744073709551533ull == prime_iterator_prev(&it));
+
+    prime_iterator_free(&it);
+
+    check_prime_iterator(1000000000, 2000);
+    check_prime_iterator(1ull << 52, 2000);
+    /* Beyond the square of the cached base primes */
+    check_prime_iterator((1ull << 62) + 12345, 500);
+    check_prime_iterator(UINT64_MAX - 30000, 500);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int prime_count_test() {
+    assert(0 == prime_count(0));
+    assert(0 == prime_count(1));
+    assert(1 == prime_count(2));
+    assert(2 == prime_count(3));
+    assert(4 == prime_count(10));
+    assert(25 == prime_count(100));
+    assert(78498 == prime_count(1000000));
+    assert(50847534 == prime_count(1000000000));
+    assert(455052511 == prime_count(10000000000ull));
+
+    uint64_t count = 0;
+
+    for (uint64_t n = 0; n < 10000; ++n) {
+        if (is_prime_u64(n)) ++count;
+        assert(count == prime_count(n));
+    }
+
+    assert(0 == nth_prime(0));
+    assert(2 == nth_prime(1));
+    assert(13 == nth_prime(6));
+    assert(999983 == nth_prime(78498));
+    assert(999999937 == nth_prime(50847534));
+    assert(22801763489ull == nth_prime(1000000000));
+
+    /* Beyond 2^64 */
+    assert(0 == nth_prime(425656284035217743ull + 1));
+
+    /* Identical results from the table */
+    assert(prime_table_init(2000000));
+
+    for (uint64_t x = 0; x <= 2000000; x += 9973) {
+        assert(prime_count(x) == prime_range_foreach(0, x + 1, count_prime,
+                                                     &count));
+    }
+
+    assert(148933 == prime_count(2000000));
+    assert(999983 == nth_prime(78498));
+    assert(2000003 == nth_prime(148934));
+
+    prime_table_free();
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/**
+ * Checks entry i of f against the factorization of n
+ */
+static void check_arithmetic_functions(const arithmetic_functions *f,
+                                       size_t i, uint64_t n) {
+    uint64_t factors[FACTORIZE_MAX_FACTORS] = {0};
+    uint32_t exponents[FACTORIZE_MAX_FACTORS] = {0};
+    size_t num_factors = factorize_u64(n, factors, exponents);
+
+    uint64_t phi = n;
+    int8_t mu = (0 == n) ? 0 : 1;
+    uint32_t tau = (0 == n) ? 0 : 1;
+    uint64_t sigma = (0 == n) ? 0 : 1;
+
+    for (size_t k = 0; k < num_factors; ++k) {
+        const uint64_t p = factors[k];
+        uint64_t divisor_sum = 1;
+
+        for (uint32_t e = 0; e < exponents[k]; ++e) {
+            divisor_sum = divisor_sum * p + 1;
+        }
+
+        phi = phi / p * (p - 1);
+        mu = (1 < exponents[k]) ? 0 : -mu;
+        tau *= exponents[k] + 1;
+        sigma *= divisor_sum;
+    }
+
+    if (0 != f->phi) assert(phi == f->phi[i]);
+    if (0 != f->mu) assert(mu == f->mu[i]);
+    if (0 != f->tau) assert(tau == f->tau[i]);
+    if (0 != f->sigma) assert(sigma == f->sigma[i]);
+    if (0 != f->omega) assert(num_factors == f->omega[i]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define ARITHMETIC_TEST_LIMIT 100000
+
+static int arithmetic_functions_test() {
+    arithmetic_functions f = {
+        .phi = calloc(ARITHMETIC_TEST_LIMIT, sizeof(uint64_t)),
+        .mu = calloc(ARITHMETIC_TEST_LIMIT, sizeof(int8_t)),
+        .tau = calloc(ARITHMETIC_TEST_LIMIT, sizeof(uint32_t)),
+        .sigma = calloc(ARITHMETIC_TEST_LIMIT, sizeof(uint64_t)),
+        .omega = calloc(ARITHMETIC_TEST_LIMIT, sizeof(uint8_t)),
+    };
+
+    assert((0 != f.phi) && (0 != f.mu) && (0 != f.tau) && (0 != f.sigma) &&
+           (0 != f.omega));
+
+    assert(arithmetic_functions_sieve(0, &f));
+    assert(arithmetic_functions_sieve(1, &f));
+    check_arithmetic_functions(&f, 0, 0);
+    assert(arithmetic_functions_sieve(2, &f));
+    check_arithmetic_functions(&f, 1, 1);
+    assert(!arithmetic_functions_sieve((1ull << 32) + 1, &f));
+
+    assert(arithmetic_functions_sieve(ARITHMETIC_TEST_LIMIT, &f));
+
+    for (uint64_t n = 0; n < ARITHMETIC_TEST_LIMIT; ++n) {
+        check_arithmetic_functions(&f, n, n);
+    }
+
+    assert(36 == f.phi[37]);
+    assert(-1 == f.mu[30]);
+    assert(0 == f.mu[12]);
+    assert(12 == f.tau[60]);
+    assert(168 == f.sigma[60]);
+    assert(3 == f.omega[60]);
+
+    int8_t *mu = calloc(ARITHMETIC_TEST_LIMIT, sizeof(int8_t));
+    uint32_t *tau = calloc(ARITHMETIC_TEST_LIMIT, sizeof(uint32_t));
+    assert((0 != mu) && (0 != tau));
+
+    /* Skipped arrays stay untouched */
+    arithmetic_functions only_mu = {.mu = mu};
+    f.mu[0] = 3;
+
+    assert(arithmetic_functions_sieve(ARITHMETIC_TEST_LIMIT, &only_mu));
+    assert(3 == f.mu[0]);
+    f.mu[0] = 0;
+    assert(0 == memcmp(f.mu, mu, ARITHMETIC_TEST_LIMIT * sizeof(int8_t)));
+
+    arithmetic_functions only_tau = {.tau = tau};
+    assert(arithmetic_functions_sieve(ARITHMETIC_TEST_LIMIT, &only_tau));
+    assert(0 == memcmp(f.tau, tau, ARITHMETIC_TEST_LIMIT * sizeof(uint32_t)));
+
+    /* Segmented, against the linear sieve */
+    arithmetic_functions segmented = {.mu = mu, .tau = tau};
+    memset(mu, 0, ARITHMETIC_TEST_LIMIT * sizeof(int8_t));
+    memset(tau, 0, ARITHMETIC_TEST_LIMIT * sizeof(uint32_t));
+
+    assert(arithmetic_functions_range(0, ARITHMETIC_TEST_LIMIT, &segmented));
+    assert(0 == memcmp(f.mu, mu, ARITHMETIC_TEST_LIMIT * sizeof(int8_t)));
+    assert(0 == memcmp(f.tau, tau, ARITHMETIC_TEST_LIMIT * sizeof(uint32_t)));
+
+    assert(arithmetic_functions_range(12345, ARITHMETIC_TEST_LIMIT - 1,
+                                      &segmented));
+    assert(0 == memcmp(f.mu + 12345, mu,
+                       (ARITHMETIC_TEST_LIMIT - 12346) * sizeof(int8_t)));
+    assert(0 == memcmp(f.tau + 12345, tau,
+                       (ARITHMETIC_TEST_LIMIT - 12346) * sizeof(uint32_t)));
+
+    free(mu);
+    free(tau);
+
+    /* Windows across several segments and odd bounds, high up */
+    const uint64_t windows[][2] = {
+        {0, 0},
+        {0, 1},
+        {1, 2},
+        {7, 1000},
+        {1000000007, 1000000007 + 1000},
+        {(1ull << 40) - 1234, (1ull << 40) + 1234},
+        {(1ull << 61) - 1000, 1ull << 61},
+    };
+
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+        const uint64_t lo = windows[w][0];
+        const uint64_t hi = windows[w][1];
+
+        assert(arithmetic_functions_range(lo, hi, &f));
+
+        for (uint64_t n = lo; n < hi; ++n) {
+            check_arithmetic_functions(&f, n - lo, n);
+        }
+    }
+
+    /* sigma might overflow beyond 2^61 */
+    assert(!arithmetic_functions_range(1ull << 61, (1ull << 61) + 1, &f));
+
+    arithmetic_functions no_sigma = f;
+    no_sigma.sigma = 0;
+
+    assert(arithmetic_functions_range(UINT64_MAX - 1000, UINT64_MAX,
+                                      &no_sigma));
+
+    for (uint64_t n = UINT64_MAX - 1000; n < UINT64_MAX; ++n) {
+        check_arithmetic_functions(&no_sigma, n - (UINT64_MAX - 1000), n);
+    }
+
+    free(f.phi);
+    free(f.mu);
+    free(f.tau);
+    free(f.sigma);
+    free(f.omega);
+
+    return EXIT_SUCCESS;
+}
+
+
+/*----------------------------------------------------------------------------*/
+
+static int gcd_u64_array_test() {
+    uint64_t a[ARRAY_TEST_COUNT] = {0, 0, 12, UINT64_MAX, 1ull << 63};
+    uint64_t b[ARRAY_TEST_COUNT] = {0, 7, 0, 3, 1ull << 40};
+    uint64_t gcds[ARRAY_TEST_COUNT] = {0};
+
+    uint64_t state = 17;
+
+    for (size_t i = 5; i < ARRAY_TEST_COUNT; ++i) {
+        /* Plant common factors now and then */
+        uint64_t common = (0 == i % 3) ? array_test_next(&state) >> 40 : 1;
+
+        a[i] = (array_test_next(&state) >> (i % 40)) * common;
+        b[i] = (array_test_next(&state) >> (i % 23)) * common;
+    }
+
+    gcd_u64_array(a, b, gcds, ARRAY_TEST_COUNT);
+
+    for (size_t i = 0; i < ARRAY_TEST_COUNT; ++i) {
+        assert(gcd_u64(a[i], b[i]) == gcds[i]);
+    }
+
+    assert(0 == gcds[0]);
+    assert(7 == gcds[1]);
+    assert(12 == gcds[2]);
+    assert(3 == gcds[3]);
+    assert((1ull << 40) == gcds[4]);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int is_prime_u64_array_test() {
+    uint64_t values[ARRAY_TEST_COUNT] = {
+        0, 1, 2, 3, 4, 251, 253, 257, 251 * 251, 251 * 257, 561,
+        /* strong pseudoprime to bases 2, 3, 5, 7, 11, 13, 17, 19, 23 */
+        3825123056546413051ull,
+        18446744073709551557ull, UINT64_MAX, 4294967291ull * 4294967279ull};
+
+    bool primes[ARRAY_TEST_COUNT] = {0};
+
+    uint64_t state = 4711;
+
+    for (size_t i = 15; i < ARRAY_TEST_COUNT; ++i) {
+        /* Odd numbers of varying size, to have some primes among them */
+        values[i] = (array_test_next(&state) >> (i % 50)) | 1;
+    }
+
+    is_prime_u64_array(values, primes, ARRAY_TEST_COUNT);
+
+    size_t num_primes = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_COUNT; ++i) {
+        assert(is_prime_u64(values[i]) == primes[i]);
+        num_primes += primes[i];
+    }
+
+    assert(!primes[0]);
+    assert(!primes[1]);
+    assert(primes[2]);
+    assert(primes[5]);
+    assert(!primes[8]);
+    assert(!primes[11]);
+    assert(primes[12]);
+    assert(!primes[13]);
+
+    assert(50 < num_primes);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int modpow_u64_array_test() {
+    uint64_t bases[ARRAY_TEST_COUNT] = {0};
+    uint64_t exponents[ARRAY_TEST_COUNT] = {0};
+    uint64_t moduli[ARRAY_TEST_COUNT] = {0};
+    uint64_t results[ARRAY_TEST_COUNT] = {0};
+
+    uint64_t state = 99;
+
+    for (size_t i = 0; i < ARRAY_TEST_COUNT; ++i) {
+        bases[i] = array_test_next(&state);
+        exponents[i] = array_test_next(&state) >> (i % 64);
+
+        /* Runs of equal moduli, odd and even ones, and 1 */
+        moduli[i] = (0 == i % 10) ? array_test_next(&state) | 1 : moduli[i - 1];
+        moduli[i] = (0 == i % 77) ? moduli[i] - 1 : moduli[i];
+    }
+
+    moduli[ARRAY_TEST_COUNT - 1] = 1;
+
+    modpow_u64_array(bases, exponents, moduli, results, ARRAY_TEST_COUNT);
+
+    for (size_t i = 0; i < ARRAY_TEST_COUNT; ++i) {
+        assert(modpow_u64(bases[i], exponents[i], moduli[i]) == results[i]);
+    }
+
+    assert(0 == results[ARRAY_TEST_COUNT - 1]);
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define RNG_TEST_THREADS 4
+#define RNG_TEST_VALUES 1000
+
+static void *rng_test_thread(void *arg) {
+    uint32_t *values = arg;
+
+    for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+        values[i] = random_get32(0);
+        assert(passes_rabin_miller(1000003));
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int rng_test() {
+    rng_state a = {0};
+    rng_state b = {0};
+
+    rng_init(&a);
+    rng_init(&b);
+
+    uint32_t buf[RNG_TEST_VALUES] = {0};
+    rng_fill_u32(&b, buf, RNG_TEST_VALUES);
+
+    for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+        assert(rng_next32(&a) == buf[i]);
+    }
+
+    /* The default seed replays the original generator */
+    rng_init(&a);
+    assert(random_get32(144312) == rng_next32(&a));
+
+    rng_seed(&a, 42);
+    rng_seed(&b, 42);
+    assert(rng_next32(&a) == rng_next32(&b));
+
+    rng_seed(&b, 43);
+    assert(rng_next32(&a) != rng_next32(&b));
+
+    for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+        uint32_t r = rng_range(&a, 10, 20);
+        assert((10 <= r) && (20 >= r));
+    }
+
+    assert((uint32_t)-1 == rng_range(&a, 2, 1));
+
+    /* Each thread draws from its own default generator */
+    pthread_t threads[RNG_TEST_THREADS];
+    static uint32_t values[RNG_TEST_THREADS][RNG_TEST_VALUES];
+
+    for (size_t t = 0; t < RNG_TEST_THREADS; ++t) {
+        assert(0 == pthread_create(threads + t, 0, rng_test_thread,
+                                   values[t]));
+    }
+
+    for (size_t t = 0; t < RNG_TEST_THREADS; ++t) {
+        assert(0 == pthread_join(threads[t], 0));
+    }
+
+    for (size_t t = 1; t < RNG_TEST_THREADS; ++t) {
+        assert(values[0][0] != values[t][0]);
+    }
+
+    assert(rng_default() == rng_default());
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int rng_kinds_test() {
+    rng_state a = {0};
+    rng_state b = {0};
+
+    /* Known answer of Random123 for counter 0, key 0 */
+    assert(rng_init_kind(&a, RNG_PHILOX4X32, 0));
+    assert(0x6627e8d5 == rng_next32(&a));
+    assert(0xe169c58d == rng_next32(&a));
+    assert(0x9b00dbd8bc57ac4cull == rng_next64(&a));
+
+    /* Known answers of pcg-c, pcg64_oneseq seeded by 4711 */
+    assert(rng_init_kind(&a, RNG_PCG64, 4711));
+    assert(0x55fef5e67d09e00cull == rng_next64(&a));
+    assert(0xc034d78cf39cb83cull == rng_next64(&a));
+    assert(0xc0af5eee == rng_next32(&a));
+
+    /* Known answers of the reference xoshiro256**, its state seeded by
+     * splitmix64 from 4711 */
+    assert(rng_init_kind(&a, RNG_XOSHIRO256SS, 4711));
+    assert(0xf923a38f1536545bull == rng_next64(&a));
+    assert(0x4e6686940b91ab5full == rng_next64(&a));
+    assert(0x56cf094b == rng_next32(&a));
+
+    assert(!rng_init_kind(&a, (rng_kind)17, 0));
+    assert(RNG_LCG32 == a.kind);
+
+    static uint32_t u32[RNG_TEST_VALUES];
+    static uint64_t u64[RNG_TEST_VALUES];
+    static double doubles[RNG_TEST_VALUES];
+
+    const rng_kind kinds[] = {RNG_LCG32, RNG_XOSHIRO256SS, RNG_PCG64,
+                              RNG_PHILOX4X32};
+
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k) {
+        assert(rng_init_kind(&a, kinds[k], 4711));
+        assert(rng_init_kind(&b, kinds[k], 4711));
+
+        /* Bulk and single calls give the same sequence, even if the bulk
+         * starts in the middle of a block */
+        assert(rng_next32(&a) == rng_next32(&b));
+
+        rng_fill_u32(&a, u32, RNG_TEST_VALUES - 3);
+        rng_fill_u64(&a, u64, RNG_TEST_VALUES);
+
+        for (size_t i = 0; i < RNG_TEST_VALUES - 3; ++i) {
+            assert(u32[i] == rng_next32(&b));
+        }
+
+        for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+            assert(u64[i] == rng_next64(&b));
+        }
+
+        rng_fill_double(&a, doubles, RNG_TEST_VALUES);
+
+        double sum = 0;
+
+        for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+            assert((0 <= doubles[i]) && (doubles[i] < 1));
+            sum += doubles[i];
+        }
+
+        assert(fabs(sum / RNG_TEST_VALUES - 0.5) < 0.05);
+
+        rng_seed(&b, 4712);
+        assert(kinds[k] == b.kind);
+        assert(rng_next64(&a) != rng_next64(&b));
+    }
+
+    /* Switching the generator of this thread */
+    assert(random_use(RNG_XOSHIRO256SS));
+    assert(RNG_XOSHIRO256SS == rng_default()->kind);
+
+    random_fill_u32(u32, RNG_TEST_VALUES);
+    random_fill_u64(u64, RNG_TEST_VALUES);
+    random_fill_double(doubles, RNG_TEST_VALUES);
+    assert(u32[0] != u32[1]);
+
+    uint32_t r = random_range(10, 20);
+    assert((10 <= r) && (20 >= r));
+
+    assert(random_use(RNG_LCG32));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define RNG_TEST_STREAMS 16
+
+typedef struct {
+    size_t first_stream;
+    size_t stride;
+    uint64_t sums[RNG_TEST_STREAMS];
+} rng_stream_work;
+
+static void *rng_stream_thread(void *arg) {
+    rng_stream_work *work = arg;
+
+    for (size_t i = work->first_stream; i < RNG_TEST_STREAMS;
+         i += work->stride) {
+        rng_state rng = {0};
+        assert(rng_stream(&rng, RNG_PHILOX4X32, 2020, i));
+
+        for (size_t k = 0; k < RNG_TEST_VALUES; ++k) {
+            work->sums[i] += rng_next32(&rng);
+        }
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int rng_stream_test() {
+    rng_state a = {0};
+    rng_state b = {0};
+
+    const rng_kind kinds[] = {RNG_XOSHIRO256SS, RNG_PCG64, RNG_PHILOX4X32};
+
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k) {
+        /* Stream 0 is the plain generator, stream 3 the one jumped thrice */
+        assert(rng_stream(&a, kinds[k], 99, 0));
+        assert(rng_init_kind(&b, kinds[k], 99));
+        assert(rng_next64(&a) == rng_next64(&b));
+
+        assert(rng_stream(&a, kinds[k], 99, 3));
+        assert(rng_init_kind(&b, kinds[k], 99));
+
+        for (size_t i = 0; i < 3; ++i) {
+            assert(rng_jump(&b));
+        }
+
+        for (size_t i = 0; i < 10; ++i) {
+            assert(rng_next64(&a) == rng_next64(&b));
+        }
+
+        /* Streams differ */
+        assert(rng_stream(&b, kinds[k], 99, 4));
+        assert(rng_next64(&a) != rng_next64(&b));
+
+        assert(rng_long_jump(&a));
+        assert(rng_next64(&a) != rng_next64(&b));
+    }
+
+    /* Advancing equals drawing, at any offset within a Philox block */
+    for (size_t k = 1; k < sizeof(kinds) / sizeof(kinds[0]); ++k) {
+        for (uint64_t delta = 0; delta < 40; delta += 3) {
+            assert(rng_init_kind(&a, kinds[k], 5));
+            assert(rng_init_kind(&b, kinds[k], 5));
+
+            rng_next32(&a);
+            rng_next32(&b);
+
+            assert(rng_advance(&a, delta));
+
+            for (uint64_t i = 0; i < delta; ++i) {
+                rng_next32(&b);
+            }
+
+            assert(rng_next32(&a) == rng_next32(&b));
+            assert(rng_next32(&a) == rng_next32(&b));
+        }
+    }
+
+    /* Jumping within a partially used Philox block */
+    assert(rng_init_kind(&a, RNG_PHILOX4X32, 5));
+    rng_next32(&a);
+    assert(rng_jump(&a));
+    assert(rng_stream(&b, RNG_PHILOX4X32, 5, 1));
+    rng_next32(&b);
+    assert(rng_next32(&a) == rng_next32(&b));
+
+    rng_init(&a);
+    assert(!rng_jump(&a));
+    assert(!rng_long_jump(&a));
+    assert(!rng_advance(&a, 1));
+    assert(!rng_stream(&a, RNG_LCG32, 1, 1));
+
+    assert(rng_init_kind(&a, RNG_XOSHIRO256SS, 1));
+    assert(!rng_advance(&a, 1));
+
+    /* Results do not depend on the number of threads */
+    static rng_stream_work sequential = {.first_stream = 0, .stride = 1};
+    rng_stream_thread(&sequential);
+
+    pthread_t threads[RNG_TEST_THREADS];
+    static rng_stream_work parallel[RNG_TEST_THREADS];
+
+    for (size_t t = 0; t < RNG_TEST_THREADS; ++t) {
+        parallel[t].first_stream = t;
+        parallel[t].stride = RNG_TEST_THREADS;
+        assert(0 == pthread_create(threads + t, 0, rng_stream_thread,
+                                   parallel + t));
+    }
+
+    for (size_t t = 0; t < RNG_TEST_THREADS; ++t) {
+        assert(0 == pthread_join(threads[t], 0));
+    }
+
+    for (size_t i = 0; i < RNG_TEST_STREAMS; ++i) {
+        assert(sequential.sums[i] ==
+               parallel[i % RNG_TEST_THREADS].sums[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int rng_bounded_test() {
+    rng_state a = {0};
+    rng_state b = {0};
+
+    static uint32_t u32[RNG_TEST_VALUES];
+    static uint64_t u64[RNG_TEST_VALUES];
+
+    /* Ranges just above a power of 2 reject almost every other number */
+    const uint32_t ranges32[] = {1, 6, 1000, (1u << 31) + 1, 0};
+    const uint64_t ranges64[] = {1, 6, 1ull << 40, (1ull << 63) + 1, 0};
+
+    for (size_t r = 0; r < sizeof(ranges32) / sizeof(ranges32[0]); ++r) {
+        assert(rng_init_kind(&a, RNG_PCG64, 7));
+        assert(rng_init_kind(&b, RNG_PCG64, 7));
+
+        rng_fill_bounded32(&a, ranges32[r], u32, RNG_TEST_VALUES);
+        rng_fill_bounded64(&a, ranges64[r], u64, RNG_TEST_VALUES);
+
+        for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+            assert(u32[i] == rng_bounded32(&b, ranges32[r]));
+            assert((0 == ranges32[r]) || (u32[i] < ranges32[r]));
+        }
+
+        for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+            assert(u64[i] == rng_bounded64(&b, ranges64[r]));
+            assert((0 == ranges64[r]) || (u64[i] < ranges64[r]));
+        }
+
+        assert(rng_next64(&a) == rng_next64(&b));
+    }
+
+    /* Roughly uniform */
+    uint32_t counts[6] = {0};
+
+    for (size_t i = 0; i < 60000; ++i) {
+        ++counts[rng_bounded32(&a, 6)];
+    }
+
+    for (size_t i = 0; i < 6; ++i) {
+        assert((9000 < counts[i]) && (counts[i] < 11000));
+    }
+
+    /* Bounds are inclusive and hit */
+    bool seen[2] = {false, false};
+
+    for (size_t i = 0; i < 100; ++i) {
+        seen[rng_range(&a, 0, 1)] = true;
+    }
+
+    assert(seen[0] && seen[1]);
+
+    for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+        uint64_t r = rng_range64(&a, UINT64_MAX - 10, UINT64_MAX);
+        assert(UINT64_MAX - 10 <= r);
+
+        r = random_range64(1ull << 40, 1ull << 41);
+        assert(((1ull << 40) <= r) && (r <= (1ull << 41)));
+    }
+
+    assert(UINT64_MAX == rng_range64(&a, 2, 1));
+    assert(UINT64_MAX == random_range64(2, 1));
+
+    random_fill_bounded32(10, u32, RNG_TEST_VALUES);
+    random_fill_bounded64(10, u64, RNG_TEST_VALUES);
+
+    for (size_t i = 0; i < RNG_TEST_VALUES; ++i) {
+        assert((u32[i] < 10) && (u64[i] < 10));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+#define RNG_TEST_SAMPLES 200000
+
+static int rng_distribution_test() {
+    rng_state a = {0};
+    rng_state b = {0};
+
+    assert(rng_init_kind(&a, RNG_XOSHIRO256SS, 31));
+    assert(rng_init_kind(&b, RNG_XOSHIRO256SS, 31));
+
+    static double samples[RNG_TEST_SAMPLES];
+
+    /* Monte Carlo estimate of pi */
+    size_t inside = 0;
+
+    for (size_t i = 0; i < RNG_TEST_SAMPLES; ++i) {
+        double x = rng_double(&a);
+        double y = rng_double(&a);
+
+        assert((0 <= x) && (x < 1));
+        inside += (x * x + y * y < 1);
+    }
+
+    assert(fabs(4.0 * inside / RNG_TEST_SAMPLES - 3.14159265358979) < 0.02);
+
+    for (size_t i = 0; i < 2 * RNG_TEST_SAMPLES; ++i) {
+        rng_next64(&b);
+    }
+
+    /* Normal: moments, and the tail beyond the base layer gets hit */
+    rng_fill_normal(&a, samples, RNG_TEST_SAMPLES);
+
+    double sum = 0;
+    double sum_squares = 0;
+    size_t num_tail = 0;
+
+    for (size_t i = 0; i < RNG_TEST_SAMPLES; ++i) {
+        assert(samples[i] == rng_normal(&b));
+
+        sum += samples[i];
+        sum_squares += samples[i] * samples[i];
+        num_tail += (fabs(samples[i]) > 3.6541528853610088);
+    }
+
+    assert(fabs(sum / RNG_TEST_SAMPLES) < 0.01);
+    assert(fabs(sum_squares / RNG_TEST_SAMPLES - 1) < 0.02);
+    assert(0 < num_tail);
+
+    /* Exponential: mean and variance 1 */
+    rng_fill_exponential(&a, samples, RNG_TEST_SAMPLES);
+
+    sum = 0;
+    sum_squares = 0;
+
+    for (size_t i = 0; i < RNG_TEST_SAMPLES; ++i) {
+        assert(samples[i] == rng_exponential(&b));
+        assert(0 <= samples[i]);
+
+        sum += samples[i];
+        sum_squares += samples[i] * samples[i];
+    }
+
+    double mean = sum / RNG_TEST_SAMPLES;
+
+    assert(fabs(mean - 1) < 0.01);
+    assert(fabs(sum_squares / RNG_TEST_SAMPLES - mean * mean - 1) < 0.03);
+
+    random_fill_normal(samples, 10);
+    random_fill_exponential(samples, 10);
+
+    assert((0 <= random_double()) && (random_double() < 1));
+    assert(0 <= random_exponential());
+    assert(isfinite(random_normal()));
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static int random_range_test() {
+    long r = random_range(10, 20);
+    assert((10 <= r) && (20 >= r));
+
+    r = random_range(0, 32000);
+    assert((0 <= r) && (32000 >= r));
+
+    // random_range(0, 0) will give rands between 0 and RAND_MAX, since
+    // random_range(*, 0) indicates 'all possible values'
+    for (long i = 1; i < RAND_MAX; ++i) {
+        r = random_range(0, i);
+        assert((0 <= r) && (i >= r));
+    }
+
+    long max = 21191;
+
+    for (long i = 0; i < max; ++i) {
+        r = random_range(i, max);
+        assert((i <= r) && (max >= r));
+    }
+
+    for (long i = max; i < 2 * max; ++i) {
+        long r = random_range(i, 2 * max);
+
+        assert(r <= 2 * max);
+        assert(r >= i);
+    }
+
+    long min = RAND_MAX - 1;
+    max = RAND_MAX;
+
+    r = random_range(min, max);
+    assert((min <= r) && (max >= r));
+
+    return EXIT_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void *numerics_stats_thread(void *arg) {
+    numerics_stats *stats = arg;
+
+    numerics_stats_reset();
+
+    for (uint64_t i = 1; i <= 100; ++i) {
+        gcd_u64(i, 100);
+    }
+
+    numerics_stats_snapshot(stats);
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static int numerics_stats_test() {
+    const numerics_stats zero = {0};
+    numerics_stats stats = {0};
+
+    numerics_stats_reset();
+    gcd_u64(12, 18);
+    is_prime(1000003);
+
+    if (!numerics_stats_snapshot(&stats)) {
+        /* Built without NUMERICS_STATS */
+        assert(0 == memcmp(&zero, &stats, sizeof(stats)));
+        return EXIT_SUCCESS;
+    }
+
+    numerics_stats_reset();
+    assert(numerics_stats_snapshot(&stats));
+    assert(0 == memcmp(&zero, &stats, sizeof(stats)));
+
+    gcd_u64(12, 18);
+    assert(6 == greatest_common_divisor(12, -18));
+    mulmod_u64(3, 4, 5);
+
+    numerics_stats_snapshot(&stats);
+    assert(2 == stats.gcds);
+    assert(1 == stats.calls[NUMERICS_TIMER_GREATEST_COMMON_DIVISOR]);
+    assert(1 == stats.modmuls);
+    assert(0 == stats.trial_divisions);
+    assert(0 == stats.rabin_miller_rounds);
+
+    /* 1000003 is prime: No small prime divides it, and no base witnesses */
+    numerics_stats_reset();
+    assert(is_prime_u64(1000003));
+    assert(passes_rabin_miller(1000003));
+
+    numerics_stats_snapshot(&stats);
+    assert(15 == stats.trial_divisions);
+    assert(1 < stats.rabin_miller_rounds);
+    assert(8 >= stats.rabin_miller_rounds);
+    assert(20 * stats.rabin_miller_rounds < stats.modmuls);
+    assert(1 == stats.calls[NUMERICS_TIMER_PASSES_RABIN_MILLER]);
+    assert(0 == stats.calls[NUMERICS_TIMER_IS_PRIME]);
+
+    numerics_stats_reset();
+    assert(1000003 == next_prime(1000000));
+
+    numerics_stats_snapshot(&stats);
+    assert(1 == stats.calls[NUMERICS_TIMER_NEXT_PRIME]);
+
+    if (1000003 <= prime_table_limit()) {
+        assert(1 == stats.sieve_hits);
+    } else {
+        /* 1000001 = 101 * 9901 */
+        assert(3 == stats.calls[NUMERICS_TIMER_IS_PRIME]);
+        assert(0 < stats.trial_divisions);
+    }
+
+    /* Other threads count on their own */
+    numerics_stats_reset();
+    gcd_u64(12, 18);
+
+    numerics_stats thread_stats = {0};
+    pthread_t thread = {0};
+    assert(0 == pthread_create(&thread, 0, numerics_stats_thread,
+                               &thread_stats));
+    assert(0 == pthread_join(thread, 0));
+
+    assert(100 == thread_stats.gcds);
+    numerics_stats_snapshot(&stats);
+    assert(1 == stats.gcds);
+
+    char *text = 0;
+    size_t text_size = 0;
+    FILE *out = open_memstream(&text, &text_size);
+    assert(0 != out);
+
+    numerics_stats_dump(out, &thread_stats);
+    numerics_stats_dump(out, 0);
+    fclose(out);
+
+    assert(0 != strstr(text, "gcds                        100\n"));
+    assert(0 != strstr(text, "gcds                        1\n"));
+    assert(0 != strstr(text, "next_prime "));
+    free(text);
+
+    numerics_stats_reset();
+    numerics_stats_snapshot(&stats);
+    assert(0 == memcmp(&zero, &stats, sizeof(stats)));
 
     return EXIT_SUCCESS;
 }
@@ -248,13 +2059,39 @@ static int random_range_test() {
 int main(int argc, char** argv) {
 
     greatest_common_divisor_test();
+    gcd_u64_test();
+    extended_greatest_common_divisor_test();
+    batch_gcd_u64_test();
     smallest_common_multiple_test();
+    modinv_u64_test();
+    modinv_batch_u64_test();
+    crt_u64_test();
+    mulmod_u64_test();
+    modpow_u64_test();
+    montgomery_test();
     is_even_test();
     is_prime_test();
     is_large_prime_test();
+    is_prime_u64_test();
     passes_rabin_miller_test();
     next_prime_factor_test();
+    factorize_u64_test();
+    prime_table_test();
+    prime_range_test();
+    prime_range_parallel_test();
+    prime_iterator_test();
+    prime_count_test();
+    arithmetic_functions_test();
+    gcd_u64_array_test();
+    is_prime_u64_array_test();
+    modpow_u64_array_test();
+    rng_test();
+    rng_kinds_test();
+    rng_stream_test();
+    rng_bounded_test();
+    rng_distribution_test();
     random_range_test();
+    numerics_stats_test();
 
 }
 
@@ -0,0 +1,85 @@
+/*
+ * (C) 2020 Michael J. Beer
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or with‐
+ * out modification, are permitted provided that the following  con‐
+ * ditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above  copy‐
+ * right  notice,  this  list  of  conditions and the following dis‐
+ * claimer in the documentation and/or other materials provided with
+ * the distribution.
+ *
+ * 3.  Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote  products  derived
+ * from this software without specific prior written permission.
+ *
+ * THIS  SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBU‐
+ * TORS "AS IS" AND ANY EXPRESS OR  IMPLIED  WARRANTIES,  INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT
+ * SHALL  THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DI‐
+ * RECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR  CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS IN‐
+ * TERRUPTION)  HOWEVER  CAUSED  AND  ON  ANY  THEORY  OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING  NEGLI‐
+ * GENCE  OR  OTHERWISE)  ARISING  IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @author Michael J. Beer <michael.josef.beer@gmail.com>
+ *
+ */
+
+/*
+ * Builds the prime table up to some limit and stores it for
+ * prime_table_load:
+ *
+ *     prime_table_gen LIMIT FILE
+ */
+#include "numerics.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    if (3 != argc) {
+        fprintf(stderr, "Usage: %s LIMIT FILE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char *end = 0;
+    errno = 0;
+    unsigned long long limit = strtoull(argv[1], &end, 0);
+
+    if ((0 != errno) || (end == argv[1]) || (0 != *end) || (limit < 2)) {
+        fprintf(stderr, "Invalid limit: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    if (!prime_table_init(limit)) {
+        fprintf(stderr, "Could not build the table up to %llu\n", limit);
+        return EXIT_FAILURE;
+    }
+
+    if (!prime_table_save(argv[2])) {
+        fprintf(stderr, "Could not write %s\n", argv[2]);
+        prime_table_free();
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stdout, "%s: primes up to %" PRIu64 "\n", argv[2],
+            prime_table_limit());
+
+    prime_table_free();
+
+    return EXIT_SUCCESS;
+}